@@ -47,6 +47,8 @@ else()
 endif()
 option(WITH_WARNINGS    "Show all warnings during compile"                            0)
 option(WITH_COREDEBUG   "Include additional debug-code in core"                       0)
+set(LOG_COMPILE_LEVEL   "1" CACHE STRING "Lowest log level compiled into the core (1 trace, 2 debug, 3 info, 4 warn, 5 error, 6 fatal)")
+set_property(CACHE LOG_COMPILE_LEVEL PROPERTY STRINGS 1 2 3 4 5 6)
 set(WITH_SOURCE_TREE    "hierarchical" CACHE STRING "Build the source tree for IDE's.")
 set_property(CACHE WITH_SOURCE_TREE PROPERTY STRINGS no flat hierarchical hierarchical-folders)
 option(WITHOUT_GIT      "Disable the GIT testing routines"                            0)
@@ -68,6 +68,15 @@ else()
   message("* Use coreside debug     : No  (default)")
 endif()
 
+if( LOG_COMPILE_LEVEL GREATER 1 )
+  message("* Lowest compiled log level : ${LOG_COMPILE_LEVEL}")
+  message(" *** messages below this level are removed from the build and")
+  message(" *** can not be enabled in the config file!")
+  add_definitions(-DTRINITY_LOG_COMPILE_LEVEL=${LOG_COMPILE_LEVEL})
+else()
+  message("* Lowest compiled log level : 1 (trace, default)")
+endif()
+
 if( NOT WITH_SOURCE_TREE STREQUAL "no" )
   message("* Show source tree       : Yes (${WITH_SOURCE_TREE})")
 else()
@@ -0,0 +1,9 @@
+DELETE FROM `rbac_permissions` WHERE `id` IN (1000, 1001);
+INSERT INTO `rbac_permissions` (`id`, `name`) VALUES
+(1000, 'Command: server profile'),
+(1001, 'Command: server profile opcodes');
+
+DELETE FROM `rbac_linked_permissions` WHERE `linkedId` IN (1000, 1001);
+INSERT INTO `rbac_linked_permissions` (`id`, `linkedId`) VALUES
+(196, 1000),
+(196, 1001);
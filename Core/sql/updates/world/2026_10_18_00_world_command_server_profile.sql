@@ -0,0 +1,4 @@
+DELETE FROM `command` WHERE `name` IN ('server profile', 'server profile opcodes');
+INSERT INTO `command` (`name`, `permission`, `help`) VALUES
+('server profile', 1000, 'Syntax: .server profile $subcommand\nType .server profile to see the list of possible subcommands or .help server profile $subcommand to see info on subcommands'),
+('server profile opcodes', 1001, 'Syntax: .server profile opcodes [#count|reset]\nShow the #count (default 20) client opcodes with the highest total handler time, or reset the counters.');
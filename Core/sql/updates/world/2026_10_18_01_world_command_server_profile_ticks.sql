@@ -0,0 +1,3 @@
+DELETE FROM `command` WHERE `name`='server profile ticks';
+INSERT INTO `command` (`name`, `permission`, `help`) VALUES
+('server profile ticks', 1002, 'Syntax: .server profile ticks [#count|reset]\nShow the time spent in each phase of the last #count (default 3) slow world updates and their slowest maps, or clear the history. Slow updates are the ones taking longer than TickProfiler.SlowTickThreshold.');
@@ -119,6 +119,198 @@ class TC_COMMON_API BIH
 
         template<typename RayCallback>
         void intersectRay(const G3D::Ray &r, RayCallback& intersectCallback, float &maxDist, bool stopAtFirst=false) const
+        {
+            traverseRay(r, maxDist, [&](int offset, int n) -> bool
+            {
+                while (n > 0) {
+                    bool hit = intersectCallback(r, objects[offset], maxDist, stopAtFirst);
+                    if (stopAtFirst && hit) return true;
+                    --n;
+                    ++offset;
+                }
+                return false;
+            });
+        }
+
+        /**
+        Same as intersectRay, but intersectCallback(ray, first, count, maxDist, stopAtFirst) tests a whole leaf at once,
+        first is a position in the object order of the tree (see getObject()) so leaves can use data stored in that order
+        */
+        template<typename LeafCallback>
+        void intersectRayLeaves(const G3D::Ray &r, LeafCallback& intersectCallback, float &maxDist, bool stopAtFirst=false) const
+        {
+            traverseRay(r, maxDist, [&](int offset, int n) -> bool
+            {
+                return intersectCallback(r, uint32(offset), uint32(n), maxDist, stopAtFirst) && stopAtFirst;
+            });
+        }
+
+        /// Object stored at position index of the tree order
+        uint32 getObject(uint32 index) const { return objects[index]; }
+
+        template<typename IsectCallback>
+        void intersectPoint(const G3D::Vector3 &p, IsectCallback& intersectCallback) const
+        {
+            if (!bounds.contains(p))
+                return;
+
+            StackNode stack[MAX_STACK_SIZE];
+            int stackPos = 0;
+            int node = 0;
+
+            while (true) {
+                while (true)
+                {
+                    uint32 tn = tree[node];
+                    uint32 axis = (tn & (3 << 30)) >> 30;
+                    bool BVH2 = (tn & (1 << 29)) != 0;
+                    int offset = tn & ~(7 << 29);
+                    if (!BVH2)
+                    {
+                        if (axis < 3)
+                        {
+                            // "normal" interior node
+                            float tl = intBitsToFloat(tree[node + 1]);
+                            float tr = intBitsToFloat(tree[node + 2]);
+                            // point is between clip zones
+                            if (tl < p[axis] && tr > p[axis])
+                                break;
+                            int right = offset + 3;
+                            node = right;
+                            // point is in right node only
+                            if (tl < p[axis]) {
+                                continue;
+                            }
+                            node = offset; // left
+                            // point is in left node only
+                            if (tr > p[axis]) {
+                                continue;
+                            }
+                            // point is in both nodes
+                            // push back right node
+                            stack[stackPos].node = right;
+                            stackPos++;
+                            continue;
+                        }
+                        else
+                        {
+                            // leaf - test some objects
+                            int n = tree[node + 1];
+                            while (n > 0) {
+                                intersectCallback(p, objects[offset]); // !!!
+                                --n;
+                                ++offset;
+                            }
+                            break;
+                        }
+                    }
+                    else // BVH2 node (empty space cut off left and right)
+                    {
+                        if (axis>2)
+                            return; // should not happen
+                        float tl = intBitsToFloat(tree[node + 1]);
+                        float tr = intBitsToFloat(tree[node + 2]);
+                        node = offset;
+                        if (tl > p[axis] || tr < p[axis])
+                            break;
+                        continue;
+                    }
+                } // traversal loop
+
+                // stack is empty?
+                if (stackPos == 0)
+                    return;
+                // move back up the stack
+                stackPos--;
+                node = stack[stackPos].node;
+            }
+        }
+
+        /// Calls intersectCallback(entry) for every object in a leaf whose clip range overlaps box
+        template<typename BoxCallback>
+        void intersectBox(const G3D::AABox &box, BoxCallback& intersectCallback) const
+        {
+            if (!bounds.intersects(box))
+                return;
+
+            StackNode stack[MAX_STACK_SIZE];
+            int stackPos = 0;
+            int node = 0;
+
+            while (true) {
+                while (true)
+                {
+                    uint32 tn = tree[node];
+                    uint32 axis = (tn & (3 << 30)) >> 30;
+                    bool BVH2 = (tn & (1 << 29)) != 0;
+                    int offset = tn & ~(7 << 29);
+                    if (!BVH2)
+                    {
+                        if (axis < 3)
+                        {
+                            // "normal" interior node
+                            float tl = intBitsToFloat(tree[node + 1]);
+                            float tr = intBitsToFloat(tree[node + 2]);
+                            bool left = box.low()[axis] <= tl;
+                            bool right = box.high()[axis] >= tr;
+                            // box is between clip zones
+                            if (!left && !right)
+                                break;
+                            node = offset + 3;
+                            // box is in right node only
+                            if (!left)
+                                continue;
+                            node = offset; // left
+                            // box is in left node only
+                            if (!right)
+                                continue;
+                            // box is in both nodes
+                            // push back right node
+                            stack[stackPos].node = offset + 3;
+                            stackPos++;
+                            continue;
+                        }
+                        else
+                        {
+                            // leaf - test some objects
+                            int n = tree[node + 1];
+                            while (n > 0) {
+                                intersectCallback(objects[offset]);
+                                --n;
+                                ++offset;
+                            }
+                            break;
+                        }
+                    }
+                    else // BVH2 node (empty space cut off left and right)
+                    {
+                        if (axis>2)
+                            return; // should not happen
+                        float tl = intBitsToFloat(tree[node + 1]);
+                        float tr = intBitsToFloat(tree[node + 2]);
+                        node = offset;
+                        if (tl > box.high()[axis] || tr < box.low()[axis])
+                            break;
+                        continue;
+                    }
+                } // traversal loop
+
+                // stack is empty?
+                if (stackPos == 0)
+                    return;
+                // move back up the stack
+                stackPos--;
+                node = stack[stackPos].node;
+            }
+        }
+
+        bool writeToFile(FILE* wf) const;
+        bool readFromFile(FILE* rf);
+
+    protected:
+        /// Walks the leaves hit by r from front to back, stops when testLeaf(offset, count) returns true
+        template<typename LeafFunc>
+        void traverseRay(const G3D::Ray &r, float &maxDist, LeafFunc testLeaf) const
         {
             float intervalMin = -1.f;
             float intervalMax = -1.f;
@@ -215,13 +407,8 @@ class TC_COMMON_API BIH
                         else
                         {
                             // leaf - test some objects
-                            int n = tree[node + 1];
-                            while (n > 0) {
-                                bool hit = intersectCallback(r, objects[offset], maxDist, stopAtFirst);
-                                if (stopAtFirst && hit) return;
-                                --n;
-                                ++offset;
-                            }
+                            if (testLeaf(offset, int(tree[node + 1])))
+                                return;
                             break;
                         }
                     }
@@ -256,88 +443,6 @@ class TC_COMMON_API BIH
             }
         }
 
-        template<typename IsectCallback>
-        void intersectPoint(const G3D::Vector3 &p, IsectCallback& intersectCallback) const
-        {
-            if (!bounds.contains(p))
-                return;
-
-            StackNode stack[MAX_STACK_SIZE];
-            int stackPos = 0;
-            int node = 0;
-
-            while (true) {
-                while (true)
-                {
-                    uint32 tn = tree[node];
-                    uint32 axis = (tn & (3 << 30)) >> 30;
-                    bool BVH2 = (tn & (1 << 29)) != 0;
-                    int offset = tn & ~(7 << 29);
-                    if (!BVH2)
-                    {
-                        if (axis < 3)
-                        {
-                            // "normal" interior node
-                            float tl = intBitsToFloat(tree[node + 1]);
-                            float tr = intBitsToFloat(tree[node + 2]);
-                            // point is between clip zones
-                            if (tl < p[axis] && tr > p[axis])
-                                break;
-                            int right = offset + 3;
-                            node = right;
-                            // point is in right node only
-                            if (tl < p[axis]) {
-                                continue;
-                            }
-                            node = offset; // left
-                            // point is in left node only
-                            if (tr > p[axis]) {
-                                continue;
-                            }
-                            // point is in both nodes
-                            // push back right node
-                            stack[stackPos].node = right;
-                            stackPos++;
-                            continue;
-                        }
-                        else
-                        {
-                            // leaf - test some objects
-                            int n = tree[node + 1];
-                            while (n > 0) {
-                                intersectCallback(p, objects[offset]); // !!!
-                                --n;
-                                ++offset;
-                            }
-                            break;
-                        }
-                    }
-                    else // BVH2 node (empty space cut off left and right)
-                    {
-                        if (axis>2)
-                            return; // should not happen
-                        float tl = intBitsToFloat(tree[node + 1]);
-                        float tr = intBitsToFloat(tree[node + 2]);
-                        node = offset;
-                        if (tl > p[axis] || tr < p[axis])
-                            break;
-                        continue;
-                    }
-                } // traversal loop
-
-                // stack is empty?
-                if (stackPos == 0)
-                    return;
-                // move back up the stack
-                stackPos--;
-                node = stack[stackPos].node;
-            }
-        }
-
-        bool writeToFile(FILE* wf) const;
-        bool readFromFile(FILE* rf);
-
-    protected:
         std::vector<uint32> tree;
         std::vector<uint32> objects;
         G3D::AABox bounds;
@@ -20,8 +20,14 @@
 #define _IVMAPMANAGER_H
 
 #include <string>
+#include <vector>
 #include "Define.h"
 
+namespace G3D
+{
+    class Vector3;
+}
+
 //===========================================================
 
 /**
@@ -61,6 +67,10 @@ namespace VMAP
             virtual void unloadMap(unsigned int pMapId) = 0;
 
             virtual bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2) = 0;
+            /**
+            test the line of sight from one position to each of targets (in world coordinates), results[i] is set for targets[i]
+            */
+            virtual void isInLineOfSight(unsigned int pMapId, float x, float y, float z, std::vector<G3D::Vector3> const& targets, std::vector<bool>& results) = 0;
             virtual float getHeight(unsigned int pMapId, float x, float y, float z, float maxSearchDist) = 0;
             /**
             test if we hit an object. return true if we hit one. rx, ry, rz will hold the hit position or the dest position, if no intersection was found
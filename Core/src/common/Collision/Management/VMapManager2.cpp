@@ -181,6 +181,39 @@ namespace VMAP
         return true;
     }
 
+    void VMapManager2::setEnableSimdIntersection(bool enable)
+    {
+        GroupModel::SetSimdIntersection(enable);
+    }
+
+    bool VMapManager2::isSimdIntersectionEnabled() const
+    {
+        return GroupModel::IsSimdIntersectionEnabled();
+    }
+
+    void VMapManager2::isInLineOfSight(unsigned int mapId, float x, float y, float z, std::vector<Vector3> const& targets, std::vector<bool>& results)
+    {
+        if (!isLineOfSightCalcEnabled() || IsVMAPDisabledForPtr(mapId, VMAP_DISABLE_LOS))
+        {
+            results.assign(targets.size(), true);
+            return;
+        }
+
+        InstanceTreeMap::const_iterator instanceTree = GetMapTree(mapId);
+        if (instanceTree == iInstanceMapTrees.end())
+        {
+            results.assign(targets.size(), true);
+            return;
+        }
+
+        std::vector<Vector3> internalTargets;
+        internalTargets.reserve(targets.size());
+        for (Vector3 const& target : targets)
+            internalTargets.push_back(convertPositionToInternalRep(target.x, target.y, target.z));
+
+        instanceTree->second->isInLineOfSight(convertPositionToInternalRep(x, y, z), internalTargets, results);
+    }
+
     /**
     get the hit position and return true if we hit something
     otherwise the result pos will be the dest pos
@@ -108,6 +108,7 @@ namespace VMAP
             void unloadMap(unsigned int mapId) override;
 
             bool isInLineOfSight(unsigned int mapId, float x1, float y1, float z1, float x2, float y2, float z2) override ;
+            void isInLineOfSight(unsigned int mapId, float x, float y, float z, std::vector<G3D::Vector3> const& targets, std::vector<bool>& results) override;
             /**
             fill the hit pos and return true, if an object was hit
             */
@@ -131,6 +132,10 @@ namespace VMAP
 
             void getInstanceMapTree(InstanceTreeMap &instanceMapTree);
 
+            /// SSE triangle tests for models loaded after the change
+            void setEnableSimdIntersection(bool enable);
+            bool isSimdIntersectionEnabled() const;
+
             typedef uint32(*GetLiquidFlagsFn)(uint32 liquidType);
             GetLiquidFlagsFn GetLiquidFlagsPtr;
 
@@ -175,6 +175,53 @@ namespace VMAP
     }
     //=========================================================
     /**
+    Tests all targets against the models collected in a single walk of the tree for the bounds of all rays,
+    results[i] is set to the line of sight from origin to targets[i]
+    */
+
+    void StaticMapTree::isInLineOfSight(const Vector3& origin, std::vector<Vector3> const& targets, std::vector<bool>& results) const
+    {
+        results.assign(targets.size(), true);
+        if (targets.empty())
+            return;
+
+        G3D::AABox bounds(origin);
+        for (Vector3 const& target : targets)
+            bounds.merge(target);
+
+        std::vector<uint32> candidates;
+        auto collect = [&candidates](uint32 entry) { candidates.push_back(entry); };
+        iTree.intersectBox(bounds, collect);
+        if (candidates.empty())
+            return;
+
+        for (std::size_t i = 0; i < targets.size(); ++i)
+        {
+            float maxDist = (targets[i] - origin).magnitude();
+            if (maxDist == std::numeric_limits<float>::max() || !std::isfinite(maxDist))
+            {
+                results[i] = false;
+                continue;
+            }
+
+            // prevent NaN values which can cause BIH intersection to enter infinite loop
+            if (maxDist < 1e-10f)
+                continue;
+
+            G3D::Ray ray = G3D::Ray::fromOriginAndDirection(origin, (targets[i] - origin) / maxDist);
+            for (uint32 entry : candidates)
+            {
+                float distance = maxDist;
+                if (iTreeValues[entry].intersectRay(ray, distance, true))
+                {
+                    results[i] = false;
+                    break;
+                }
+            }
+        }
+    }
+    //=========================================================
+    /**
     When moving from pos1 to pos2 check if we hit an object. Return true and the position if we hit one
     Return the hit pos or the original dest pos
     */
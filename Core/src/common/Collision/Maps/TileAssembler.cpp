@@ -21,9 +21,13 @@
 #include "BoundingIntervalHierarchy.h"
 #include "VMapDefinitions.h"
 
+#include "Timer.h"
+
+#include <atomic>
 #include <set>
 #include <iomanip>
 #include <sstream>
+#include <thread>
 
 using G3D::Vector3;
 using G3D::AABox;
@@ -35,6 +39,34 @@ template<> struct BoundsTrait<VMAP::ModelSpawn*>
     static void getBounds(const VMAP::ModelSpawn* const &obj, G3D::AABox& out) { out = obj->getBounds(); }
 };
 
+namespace
+{
+    // Calls work(i) for every i < count on up to `threads` threads, stops handing out work after the first failure
+    template<class Work>
+    bool RunParallel(std::size_t count, uint32 threads, Work work)
+    {
+        std::atomic<std::size_t> next(0);
+        std::atomic<bool> success(true);
+        auto worker = [&]()
+        {
+            for (std::size_t i = next++; i < count && success; i = next++)
+                if (!work(i))
+                    success = false;
+        };
+
+        std::vector<std::thread> workerThreads;
+        for (uint32 i = 1; i < threads && i < count; ++i)
+            workerThreads.push_back(std::thread(worker));
+
+        worker();
+
+        for (std::thread& thread : workerThreads)
+            thread.join();
+
+        return success;
+    }
+}
+
 namespace VMAP
 {
     bool readChunk(FILE* rf, char *dest, const char *compare, uint32 len)
@@ -52,8 +84,8 @@ namespace VMAP
 
     //=================================================================
 
-    TileAssembler::TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName)
-        : iDestDir(pDestDirName), iSrcDir(pSrcDirName), iFilterMethod(NULL), iCurrentUniqueNameId(0)
+    TileAssembler::TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName, uint32 threads)
+        : iDestDir(pDestDirName), iSrcDir(pSrcDirName), iFilterMethod(NULL), iCurrentUniqueNameId(0), iThreads(std::max(threads, 1u))
     {
         //mkdir(iDestDir);
         //init();
@@ -66,143 +98,173 @@ namespace VMAP
 
     bool TileAssembler::convertWorld2()
     {
+        uint32 stageStart = getMSTime();
         bool success = readMapSpawns();
         if (!success)
             return false;
 
-        // export Map data
-        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end() && success; ++map_iter)
+        uint32 readTime = GetMSTimeDiffToNow(stageStart);
+
+        // export Map data, each map writes its own tree and tile files
+        stageStart = getMSTime();
+        std::vector<std::pair<uint32, MapSpawns*>> maps(mapData.begin(), mapData.end());
+        std::vector<std::set<std::string>> mapModelFiles(maps.size());
+        success = RunParallel(maps.size(), iThreads, [&](std::size_t i)
         {
-            // build global map tree
-            std::vector<ModelSpawn*> mapSpawns;
-            UniqueEntryMap::iterator entry;
-            printf("Calculating model bounds for map %u...\n", map_iter->first);
-            for (entry = map_iter->second->UniqueEntries.begin(); entry != map_iter->second->UniqueEntries.end(); ++entry)
-            {
-                // M2 models don't have a bound set in WDT/ADT placement data, i still think they're not used for LoS at all on retail
-                if (entry->second.flags & MOD_M2)
-                {
-                    if (!calculateTransformedBound(entry->second))
-                        break;
-                }
-                else if (entry->second.flags & MOD_WORLDSPAWN) // WMO maps and terrain maps use different origin, so we need to adapt :/
-                {
-                    /// @todo remove extractor hack and uncomment below line:
-                    //entry->second.iPos += Vector3(533.33333f*32, 533.33333f*32, 0.f);
-                    entry->second.iBound = entry->second.iBound + Vector3(533.33333f*32, 533.33333f*32, 0.f);
-                }
-                mapSpawns.push_back(&(entry->second));
-                spawnedModelFiles.insert(entry->second.name);
-            }
+            return convertMap(maps[i].first, maps[i].second, mapModelFiles[i]);
+        });
 
-            printf("Creating map tree for map %u...\n", map_iter->first);
-            BIH pTree;
+        for (std::set<std::string> const& modelFiles : mapModelFiles)
+            spawnedModelFiles.insert(modelFiles.begin(), modelFiles.end());
 
-            try
-            {
-                pTree.build(mapSpawns, BoundsTrait<ModelSpawn*>::getBounds);
-            }
-            catch (std::exception& e)
+        uint32 mapTime = GetMSTimeDiffToNow(stageStart);
+
+        // add an object models, listed in temp_gameobject_models file
+        stageStart = getMSTime();
+        exportGameobjectModels();
+
+        // export objects
+        std::cout << "\nConverting Model Files" << std::endl;
+        std::vector<std::string> modelFiles(spawnedModelFiles.begin(), spawnedModelFiles.end());
+        std::atomic<std::size_t> convertedModels(0);
+        if (!RunParallel(modelFiles.size(), iThreads, [&](std::size_t i)
+        {
+            if (!convertRawFile(modelFiles[i]))
             {
-                printf("Exception ""%s"" when calling pTree.build", e.what());
+                std::cout << "error converting " << modelFiles[i] << std::endl;
                 return false;
             }
 
-            // ===> possibly move this code to StaticMapTree class
-            std::map<uint32, uint32> modelNodeIdx;
-            for (uint32 i=0; i<mapSpawns.size(); ++i)
-                modelNodeIdx.insert(pair<uint32, uint32>(mapSpawns[i]->ID, i));
+            std::size_t converted = ++convertedModels;
+            if (converted % 1000 == 0 || converted == modelFiles.size())
+                printf("Converted %u/%u model files\n", uint32(converted), uint32(modelFiles.size()));
+            return true;
+        }))
+            success = false;
+
+        uint32 modelTime = GetMSTimeDiffToNow(stageStart);
+
+        printf("Reading spawns: %u ms, map trees: %u ms, models: %u ms (%u threads)\n", readTime, mapTime, modelTime, iThreads);
+
+        //cleanup:
+        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter)
+        {
+            delete map_iter->second;
+        }
+        return success;
+    }
+
+    bool TileAssembler::convertMap(uint32 mapId, MapSpawns* spawns, std::set<std::string>& modelFiles)
+    {
+        bool success = true;
 
-            // write map tree file
-            std::stringstream mapfilename;
-            mapfilename << iDestDir << '/' << std::setfill('0') << std::setw(4) << map_iter->first << ".vmtree";
-            FILE* mapfile = fopen(mapfilename.str().c_str(), "wb");
-            if (!mapfile)
+        // build global map tree
+        std::vector<ModelSpawn*> mapSpawns;
+        UniqueEntryMap::iterator entry;
+        printf("Calculating model bounds for map %u...\n", mapId);
+        for (entry = spawns->UniqueEntries.begin(); entry != spawns->UniqueEntries.end(); ++entry)
+        {
+            // M2 models don't have a bound set in WDT/ADT placement data, i still think they're not used for LoS at all on retail
+            if (entry->second.flags & MOD_M2)
             {
-                success = false;
-                printf("Cannot open %s\n", mapfilename.str().c_str());
-                break;
+                if (!calculateTransformedBound(entry->second))
+                    break;
             }
-
-            //general info
-            if (success && fwrite(VMAP_MAGIC, 1, 8, mapfile) != 8) success = false;
-            uint32 globalTileID = StaticMapTree::packTileID(65, 65);
-            pair<TileMap::iterator, TileMap::iterator> globalRange = map_iter->second->TileEntries.equal_range(globalTileID);
-            char isTiled = globalRange.first == globalRange.second; // only maps without terrain (tiles) have global WMO
-            if (success && fwrite(&isTiled, sizeof(char), 1, mapfile) != 1) success = false;
-            // Nodes
-            if (success && fwrite("NODE", 4, 1, mapfile) != 1) success = false;
-            if (success) success = pTree.writeToFile(mapfile);
-            // global map spawns (WDT), if any (most instances)
-            if (success && fwrite("GOBJ", 4, 1, mapfile) != 1) success = false;
-
-            for (TileMap::iterator glob=globalRange.first; glob != globalRange.second && success; ++glob)
+            else if (entry->second.flags & MOD_WORLDSPAWN) // WMO maps and terrain maps use different origin, so we need to adapt :/
             {
-                success = ModelSpawn::writeToFile(mapfile, map_iter->second->UniqueEntries[glob->second]);
+                /// @todo remove extractor hack and uncomment below line:
+                //entry->second.iPos += Vector3(533.33333f*32, 533.33333f*32, 0.f);
+                entry->second.iBound = entry->second.iBound + Vector3(533.33333f*32, 533.33333f*32, 0.f);
             }
+            mapSpawns.push_back(&(entry->second));
+            modelFiles.insert(entry->second.name);
+        }
 
-            fclose(mapfile);
+        printf("Creating map tree for map %u...\n", mapId);
+        BIH pTree;
 
-            // <====
+        try
+        {
+            pTree.build(mapSpawns, BoundsTrait<ModelSpawn*>::getBounds);
+        }
+        catch (std::exception& e)
+        {
+            printf("Exception ""%s"" when calling pTree.build", e.what());
+            return false;
+        }
 
-            // write map tile files, similar to ADT files, only with extra BSP tree node info
-            TileMap &tileEntries = map_iter->second->TileEntries;
-            TileMap::iterator tile;
-            for (tile = tileEntries.begin(); tile != tileEntries.end(); ++tile)
-            {
-                const ModelSpawn &spawn = map_iter->second->UniqueEntries[tile->second];
-                if (spawn.flags & MOD_WORLDSPAWN) // WDT spawn, saved as tile 65/65 currently...
-                    continue;
-                uint32 nSpawns = tileEntries.count(tile->first);
-                std::stringstream tilefilename;
-                tilefilename.fill('0');
-                tilefilename << iDestDir << '/' << std::setw(4) << map_iter->first << '_';
-                uint32 x, y;
-                StaticMapTree::unpackTileID(tile->first, x, y);
-                tilefilename << std::setw(2) << x << '_' << std::setw(2) << y << ".vmtile";
-                if (FILE* tilefile = fopen(tilefilename.str().c_str(), "wb"))
-                {
-                    // file header
-                    if (success && fwrite(VMAP_MAGIC, 1, 8, tilefile) != 8) success = false;
-                    // write number of tile spawns
-                    if (success && fwrite(&nSpawns, sizeof(uint32), 1, tilefile) != 1) success = false;
-                    // write tile spawns
-                    for (uint32 s=0; s<nSpawns; ++s)
-                    {
-                        if (s)
-                            ++tile;
-                        const ModelSpawn &spawn2 = map_iter->second->UniqueEntries[tile->second];
-                        success = success && ModelSpawn::writeToFile(tilefile, spawn2);
-                        // MapTree nodes to update when loading tile:
-                        std::map<uint32, uint32>::iterator nIdx = modelNodeIdx.find(spawn2.ID);
-                        if (success && fwrite(&nIdx->second, sizeof(uint32), 1, tilefile) != 1) success = false;
-                    }
-                    fclose(tilefile);
-                }
-            }
-            // break; //test, extract only first map; TODO: remvoe this line
+        // ===> possibly move this code to StaticMapTree class
+        std::map<uint32, uint32> modelNodeIdx;
+        for (uint32 i=0; i<mapSpawns.size(); ++i)
+            modelNodeIdx.insert(pair<uint32, uint32>(mapSpawns[i]->ID, i));
+
+        // write map tree file
+        std::stringstream mapfilename;
+        mapfilename << iDestDir << '/' << std::setfill('0') << std::setw(4) << mapId << ".vmtree";
+        FILE* mapfile = fopen(mapfilename.str().c_str(), "wb");
+        if (!mapfile)
+        {
+            printf("Cannot open %s\n", mapfilename.str().c_str());
+            return false;
         }
 
-        // add an object models, listed in temp_gameobject_models file
-        exportGameobjectModels();
-        // export objects
-        std::cout << "\nConverting Model Files" << std::endl;
-        for (std::set<std::string>::iterator mfile = spawnedModelFiles.begin(); mfile != spawnedModelFiles.end(); ++mfile)
+        //general info
+        if (success && fwrite(VMAP_MAGIC, 1, 8, mapfile) != 8) success = false;
+        uint32 globalTileID = StaticMapTree::packTileID(65, 65);
+        pair<TileMap::iterator, TileMap::iterator> globalRange = spawns->TileEntries.equal_range(globalTileID);
+        char isTiled = globalRange.first == globalRange.second; // only maps without terrain (tiles) have global WMO
+        if (success && fwrite(&isTiled, sizeof(char), 1, mapfile) != 1) success = false;
+        // Nodes
+        if (success && fwrite("NODE", 4, 1, mapfile) != 1) success = false;
+        if (success) success = pTree.writeToFile(mapfile);
+        // global map spawns (WDT), if any (most instances)
+        if (success && fwrite("GOBJ", 4, 1, mapfile) != 1) success = false;
+
+        for (TileMap::iterator glob=globalRange.first; glob != globalRange.second && success; ++glob)
         {
-            std::cout << "Converting " << *mfile << std::endl;
-            if (!convertRawFile(*mfile))
-            {
-                std::cout << "error converting " << *mfile << std::endl;
-                success = false;
-                break;
-            }
+            success = ModelSpawn::writeToFile(mapfile, spawns->UniqueEntries[glob->second]);
         }
 
-        //cleanup:
-        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter)
+        fclose(mapfile);
+
+        // <====
+
+        // write map tile files, similar to ADT files, only with extra BSP tree node info
+        TileMap &tileEntries = spawns->TileEntries;
+        TileMap::iterator tile;
+        for (tile = tileEntries.begin(); tile != tileEntries.end(); ++tile)
         {
-            delete map_iter->second;
+            const ModelSpawn &spawn = spawns->UniqueEntries[tile->second];
+            if (spawn.flags & MOD_WORLDSPAWN) // WDT spawn, saved as tile 65/65 currently...
+                continue;
+            uint32 nSpawns = tileEntries.count(tile->first);
+            std::stringstream tilefilename;
+            tilefilename.fill('0');
+            tilefilename << iDestDir << '/' << std::setw(4) << mapId << '_';
+            uint32 x, y;
+            StaticMapTree::unpackTileID(tile->first, x, y);
+            tilefilename << std::setw(2) << x << '_' << std::setw(2) << y << ".vmtile";
+            if (FILE* tilefile = fopen(tilefilename.str().c_str(), "wb"))
+            {
+                // file header
+                if (success && fwrite(VMAP_MAGIC, 1, 8, tilefile) != 8) success = false;
+                // write number of tile spawns
+                if (success && fwrite(&nSpawns, sizeof(uint32), 1, tilefile) != 1) success = false;
+                // write tile spawns
+                for (uint32 s=0; s<nSpawns; ++s)
+                {
+                    if (s)
+                        ++tile;
+                    const ModelSpawn &spawn2 = spawns->UniqueEntries[tile->second];
+                    success = success && ModelSpawn::writeToFile(tilefile, spawn2);
+                    // MapTree nodes to update when loading tile:
+                    std::map<uint32, uint32>::iterator nIdx = modelNodeIdx.find(spawn2.ID);
+                    if (success && fwrite(&nIdx->second, sizeof(uint32), 1, tilefile) != 1) success = false;
+                }
+                fclose(tilefile);
+            }
         }
+
         return success;
     }
 
@@ -100,13 +100,16 @@ namespace VMAP
             unsigned int iCurrentUniqueNameId;
             MapData mapData;
             std::set<std::string> spawnedModelFiles;
+            uint32 iThreads;
 
         public:
-            TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName);
+            TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName, uint32 threads = 1);
             virtual ~TileAssembler();
 
             bool convertWorld2();
             bool readMapSpawns();
+            /// Builds the map tree and writes the tree and tile files of one map, collects the models it spawns
+            bool convertMap(uint32 mapId, MapSpawns* spawns, std::set<std::string>& modelFiles);
             bool calculateTransformedBound(ModelSpawn &spawn);
             void exportGameobjectModels();
 
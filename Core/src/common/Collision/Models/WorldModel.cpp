@@ -20,6 +20,12 @@
 #include "ModelInstance.h"
 #include "VMapDefinitions.h"
 #include "MapTree.h"
+#include <atomic>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VMAP_SIMD_INTERSECTION
+#include <emmintrin.h>
+#endif
 
 using G3D::Vector3;
 using G3D::Ray;
@@ -81,6 +87,94 @@ namespace VMAP
         return false;
     }
 
+    enum SimdTrianglePlane
+    {
+        SIMD_V0_X, SIMD_V0_Y, SIMD_V0_Z,
+        SIMD_E1_X, SIMD_E1_Y, SIMD_E1_Z,
+        SIMD_E2_X, SIMD_E2_Y, SIMD_E2_Z,
+        SIMD_PLANE_COUNT
+    };
+
+    std::atomic<bool> SimdIntersectionEnabled(true);
+
+#ifdef VMAP_SIMD_INTERSECTION
+    // IntersectTriangle for the triangles [first, first + count) of the SoA planes, 4 at a time
+    bool IntersectTrianglesSimd(float const* tris, uint32 stride, uint32 first, uint32 count, const G3D::Ray &ray, float &distance)
+    {
+        const __m128 eps = _mm_set1_ps(1e-5f);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+        const __m128 ox = _mm_set1_ps(ray.origin().x);
+        const __m128 oy = _mm_set1_ps(ray.origin().y);
+        const __m128 oz = _mm_set1_ps(ray.origin().z);
+        const __m128 dx = _mm_set1_ps(ray.direction().x);
+        const __m128 dy = _mm_set1_ps(ray.direction().y);
+        const __m128 dz = _mm_set1_ps(ray.direction().z);
+
+        bool hit = false;
+        uint32 end = first + count;
+        for (uint32 i = first; i < end; i += 4)
+        {
+            const __m128 e1x = _mm_loadu_ps(tris + SIMD_E1_X * stride + i);
+            const __m128 e1y = _mm_loadu_ps(tris + SIMD_E1_Y * stride + i);
+            const __m128 e1z = _mm_loadu_ps(tris + SIMD_E1_Z * stride + i);
+            const __m128 e2x = _mm_loadu_ps(tris + SIMD_E2_X * stride + i);
+            const __m128 e2y = _mm_loadu_ps(tris + SIMD_E2_Y * stride + i);
+            const __m128 e2z = _mm_loadu_ps(tris + SIMD_E2_Z * stride + i);
+
+            // p = dir x e2
+            const __m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+            const __m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+            const __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+            const __m128 a = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+            // ill-conditioned lanes divide by ~0, their results are masked out below
+            const __m128 f = _mm_div_ps(one, a);
+
+            // s = origin - v0
+            const __m128 sx = _mm_sub_ps(ox, _mm_loadu_ps(tris + SIMD_V0_X * stride + i));
+            const __m128 sy = _mm_sub_ps(oy, _mm_loadu_ps(tris + SIMD_V0_Y * stride + i));
+            const __m128 sz = _mm_sub_ps(oz, _mm_loadu_ps(tris + SIMD_V0_Z * stride + i));
+            const __m128 u = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)));
+
+            // q = s x e1
+            const __m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+            const __m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+            const __m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+            const __m128 v = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)));
+            const __m128 t = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)));
+
+            __m128 valid = _mm_cmpge_ps(_mm_and_ps(a, absMask), eps);
+            valid = _mm_and_ps(valid, _mm_cmpge_ps(u, zero));
+            valid = _mm_and_ps(valid, _mm_cmple_ps(u, one));
+            valid = _mm_and_ps(valid, _mm_cmpge_ps(v, zero));
+            valid = _mm_and_ps(valid, _mm_cmple_ps(_mm_add_ps(u, v), one));
+            valid = _mm_and_ps(valid, _mm_cmpgt_ps(t, zero));
+            valid = _mm_and_ps(valid, _mm_cmplt_ps(t, _mm_set1_ps(distance)));
+
+            int mask = _mm_movemask_ps(valid);
+            if (end - i < 4)
+                mask &= (1 << (end - i)) - 1;               // lanes past the leaf belong to other leaves or the padding
+            if (!mask)
+                continue;
+
+            float times[4];
+            _mm_storeu_ps(times, t);
+            for (int lane = 0; lane < 4; ++lane)
+            {
+                if ((mask & (1 << lane)) && times[lane] < distance)
+                {
+                    distance = times[lane];
+                    hit = true;
+                }
+            }
+        }
+
+        return hit;
+    }
+#endif
+
     class TriBoundFunc
     {
         public:
@@ -261,7 +355,8 @@ namespace VMAP
 
     GroupModel::GroupModel(const GroupModel &other):
         iBound(other.iBound), iMogpFlags(other.iMogpFlags), iGroupWMOID(other.iGroupWMOID),
-        vertices(other.vertices), triangles(other.triangles), meshTree(other.meshTree), iLiquid(nullptr)
+        vertices(other.vertices), triangles(other.triangles), meshTree(other.meshTree), iLiquid(nullptr),
+        simdTriangles(other.simdTriangles), simdStride(other.simdStride)
     {
         if (other.iLiquid)
             iLiquid = new WmoLiquid(*other.iLiquid);
@@ -273,6 +368,7 @@ namespace VMAP
         triangles.swap(tri);
         TriBoundFunc bFunc(vertices);
         meshTree.build(triangles, bFunc);
+        buildSimdTriangles();
     }
 
     bool GroupModel::writeToFile(FILE* wf)
@@ -329,6 +425,8 @@ namespace VMAP
         uint32 count = 0;
         triangles.clear();
         vertices.clear();
+        simdTriangles.clear();
+        simdStride = 0;
         delete iLiquid;
         iLiquid = NULL;
 
@@ -355,6 +453,7 @@ namespace VMAP
         // read mesh BIH
         if (result && !readChunk(rf, chunk, "MBIH", 4)) result = false;
         if (result) result = meshTree.readFromFile(rf);
+        if (result) buildSimdTriangles();
 
         // write liquid data
         if (result && !readChunk(rf, chunk, "LIQU", 4)) result = false;
@@ -379,11 +478,88 @@ namespace VMAP
         bool hit;
     };
 
+#ifdef VMAP_SIMD_INTERSECTION
+    struct GModelSimdRayCallback
+    {
+        GModelSimdRayCallback(const std::vector<float> &tris, uint32 planeStride):
+            triangles(tris.data()), stride(planeStride), hit(false) { }
+        bool operator()(const G3D::Ray& ray, uint32 first, uint32 count, float& distance, bool /*pStopAtFirstHit*/)
+        {
+            if (IntersectTrianglesSimd(triangles, stride, first, count, ray, distance))
+                hit = true;
+            return hit;
+        }
+        float const* triangles;
+        uint32 stride;
+        bool hit;
+    };
+#endif
+
+    void GroupModel::SetSimdIntersection(bool enable)
+    {
+        SimdIntersectionEnabled = enable;
+    }
+
+    bool GroupModel::IsSimdIntersectionEnabled()
+    {
+#ifdef VMAP_SIMD_INTERSECTION
+        return SimdIntersectionEnabled;
+#else
+        return false;
+#endif
+    }
+
+    void GroupModel::buildSimdTriangles()
+    {
+        simdTriangles.clear();
+        simdStride = 0;
+
+        uint32 count = meshTree.primCount();
+        if (!IsSimdIntersectionEnabled() || !count)
+            return;
+
+        // a leaf may end at the last triangle, its 4 wide loads read 3 floats past it
+        uint32 stride = count + 3;
+        std::vector<float> planes(SIMD_PLANE_COUNT * stride, 0.0f);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            uint32 entry = meshTree.getObject(i);
+            if (entry >= triangles.size())
+                return;                                     // broken tree, keep the scalar tests
+
+            const MeshTriangle &tri = triangles[entry];
+            const Vector3 &v0 = vertices[tri.idx0];
+            const Vector3 e1 = vertices[tri.idx1] - v0;
+            const Vector3 e2 = vertices[tri.idx2] - v0;
+            planes[SIMD_V0_X * stride + i] = v0.x;
+            planes[SIMD_V0_Y * stride + i] = v0.y;
+            planes[SIMD_V0_Z * stride + i] = v0.z;
+            planes[SIMD_E1_X * stride + i] = e1.x;
+            planes[SIMD_E1_Y * stride + i] = e1.y;
+            planes[SIMD_E1_Z * stride + i] = e1.z;
+            planes[SIMD_E2_X * stride + i] = e2.x;
+            planes[SIMD_E2_Y * stride + i] = e2.y;
+            planes[SIMD_E2_Z * stride + i] = e2.z;
+        }
+
+        simdTriangles.swap(planes);
+        simdStride = stride;
+    }
+
     bool GroupModel::IntersectRay(const G3D::Ray &ray, float &distance, bool stopAtFirstHit) const
     {
         if (triangles.empty())
             return false;
 
+#ifdef VMAP_SIMD_INTERSECTION
+        if (!simdTriangles.empty())
+        {
+            GModelSimdRayCallback callback(simdTriangles, simdStride);
+            meshTree.intersectRayLeaves(ray, callback, distance, stopAtFirstHit);
+            return callback.hit;
+        }
+#endif
+
         GModelRayCallback callback(triangles, vertices);
         meshTree.intersectRay(ray, callback, distance, stopAtFirstHit);
         return callback.hit;
@@ -73,10 +73,10 @@ namespace VMAP
     class TC_COMMON_API GroupModel
     {
         public:
-            GroupModel() : iBound(), iMogpFlags(0), iGroupWMOID(0), iLiquid(NULL) { }
+            GroupModel() : iBound(), iMogpFlags(0), iGroupWMOID(0), iLiquid(NULL), simdStride(0) { }
             GroupModel(const GroupModel &other);
             GroupModel(uint32 mogpFlags, uint32 groupWMOID, const G3D::AABox &bound):
-                        iBound(bound), iMogpFlags(mogpFlags), iGroupWMOID(groupWMOID), iLiquid(NULL) { }
+                        iBound(bound), iMogpFlags(mogpFlags), iGroupWMOID(groupWMOID), iLiquid(NULL), simdStride(0) { }
             ~GroupModel() { delete iLiquid; }
 
             //! pass mesh data to object and create BIH. Passed vectors get get swapped with old geometry!
@@ -92,7 +92,13 @@ namespace VMAP
             uint32 GetMogpFlags() const { return iMogpFlags; }
             uint32 GetWmoID() const { return iGroupWMOID; }
             void getMeshData(std::vector<G3D::Vector3>& outVertices, std::vector<MeshTriangle>& outTriangles, WmoLiquid*& liquid);
+
+            /// Use SSE triangle tests for groups read after the change, ignored when built without SSE2
+            static void SetSimdIntersection(bool enable);
+            static bool IsSimdIntersectionEnabled();
         protected:
+            void buildSimdTriangles();
+
             G3D::AABox iBound;
             uint32 iMogpFlags;// 0x8 outdor; 0x2000 indoor
             uint32 iGroupWMOID;
@@ -100,6 +106,11 @@ namespace VMAP
             std::vector<MeshTriangle> triangles;
             BIH meshTree;
             WmoLiquid* iLiquid;
+
+            //! first vertex and both edges of each triangle in meshTree object order, split by component,
+            //! each plane padded for 4 wide loads. Empty if the scalar tests are used
+            std::vector<float> simdTriangles;
+            uint32 simdStride;
     };
 
     /*! Holds a model (converted M2 or WMO) in its original coordinate space */
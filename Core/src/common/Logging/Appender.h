@@ -102,6 +102,9 @@ class TC_COMMON_API Appender
         static const char* getLogLevelString(LogLevel level);
         virtual void setRealmId(uint32 /*realmId*/) { }
 
+        /// Called after a batch of messages was written
+        virtual void Flush() { }
+
     private:
         virtual void _write(LogMessage const* /*message*/) = 0;
 
@@ -24,6 +24,11 @@
 # include <Windows.h>
 #endif
 
+namespace
+{
+    std::size_t const MaxDynamicFiles = 64;
+}
+
 AppenderFile::AppenderFile(uint8 id, std::string const& name, LogLevel level, AppenderFlags flags, ExtraAppenderArgs extraArgs) :
     Appender(id, name, level, flags),
     logfile(NULL),
@@ -63,6 +68,7 @@ AppenderFile::AppenderFile(uint8 id, std::string const& name, LogLevel level, Ap
 
 AppenderFile::~AppenderFile()
 {
+    std::lock_guard<std::mutex> lock(_filesLock);
     CloseFile();
 }
 
@@ -70,18 +76,41 @@ void AppenderFile::_write(LogMessage const* message)
 {
     bool exceedMaxSize = _maxFileSize > 0 && (_fileSize.load() + message->Size()) > _maxFileSize;
 
+    std::lock_guard<std::mutex> lock(_filesLock);
     if (_dynamicName)
     {
         char namebuf[TRINITY_PATH_MAX];
         snprintf(namebuf, TRINITY_PATH_MAX, _fileName.c_str(), message->param1.c_str());
-        // always use "a" with dynamic name otherwise it could delete the log we wrote in last _write() call
-        FILE* file = OpenFile(namebuf, "a", _backup || exceedMaxSize);
+
+        FILE* file = NULL;
+        std::unordered_map<std::string, FILE*>::iterator itr = _dynamicFiles.find(namebuf);
+        if (itr != _dynamicFiles.end())
+        {
+            file = itr->second;
+            if (exceedMaxSize)
+            {
+                fclose(file);
+                _dynamicFiles.erase(itr);
+                file = NULL;
+            }
+        }
+
         if (!file)
-            return;
+        {
+            // keep a bounded number of files open, these appenders are used with one file per account or character
+            if (_dynamicFiles.size() >= MaxDynamicFiles)
+                CloseDynamicFiles();
+
+            // always use "a" with dynamic name otherwise it could delete the log we wrote in last _write() call
+            file = OpenFile(namebuf, "a", _backup || exceedMaxSize);
+            if (!file)
+                return;
+
+            _dynamicFiles[namebuf] = file;
+        }
+
         fprintf(file, "%s%s\n", message->prefix.c_str(), message->text.c_str());
-        fflush(file);
         _fileSize += uint64(message->Size());
-        fclose(file);
         return;
     }
     else if (exceedMaxSize)
@@ -91,16 +120,27 @@ void AppenderFile::_write(LogMessage const* message)
         return;
 
     fprintf(logfile, "%s%s\n", message->prefix.c_str(), message->text.c_str());
-    fflush(logfile);
     _fileSize += uint64(message->Size());
 }
 
+void AppenderFile::Flush()
+{
+    std::lock_guard<std::mutex> lock(_filesLock);
+    if (logfile)
+        fflush(logfile);
+
+    for (std::pair<std::string const, FILE*>& file : _dynamicFiles)
+        fflush(file.second);
+}
+
 FILE* AppenderFile::OpenFile(std::string const& filename, std::string const& mode, bool backup)
 {
     std::string fullName(_logDir + filename);
     if (backup)
     {
-        CloseFile();
+        if (!_dynamicName)
+            CloseFile();
+
         std::string newName(fullName);
         newName.push_back('.');
         newName.append(LogMessage::getTimeStr(time(NULL)));
@@ -124,4 +164,14 @@ void AppenderFile::CloseFile()
         fclose(logfile);
         logfile = NULL;
     }
+
+    CloseDynamicFiles();
+}
+
+void AppenderFile::CloseDynamicFiles()
+{
+    for (std::pair<std::string const, FILE*>& file : _dynamicFiles)
+        fclose(file.second);
+
+    _dynamicFiles.clear();
 }
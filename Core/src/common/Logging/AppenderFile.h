@@ -19,6 +19,8 @@
 #define APPENDERFILE_H
 
 #include <atomic>
+#include <mutex>
+#include <unordered_map>
 #include "Appender.h"
 
 class TC_COMMON_API AppenderFile : public Appender
@@ -30,11 +32,16 @@ class TC_COMMON_API AppenderFile : public Appender
         ~AppenderFile();
         FILE* OpenFile(std::string const& name, std::string const& mode, bool backup);
         AppenderType getType() const override { return TypeIndex::value; }
+        void Flush() override;
 
     private:
+        // callers hold _filesLock
         void CloseFile();
+        void CloseDynamicFiles();
         void _write(LogMessage const* message) override;
         FILE* logfile;
+        std::unordered_map<std::string, FILE*> _dynamicFiles;   // open files of a dynamic name appender, by file name
+        std::mutex _filesLock;                                  // guards logfile and _dynamicFiles, synchronous logging writes from map and session threads
         std::string _fileName;
         std::string _logDir;
         bool _dynamicName;
@@ -30,8 +30,12 @@
 #include <sstream>
 #include <iostream>
 
-Log::Log() : AppenderId(0), lowestLogLevel(LOG_LEVEL_FATAL), _ioContext(nullptr), _strand(nullptr)
+Log::Log() : AppenderId(0), lowestLogLevel(LOG_LEVEL_FATAL), _ioContext(nullptr), _strand(nullptr),
+    _writeScheduled(false), _queueLimit(0), _writtenMessages(0), _droppedMessages(0)
 {
+    for (std::atomic<uint8>& level : _filterLevels)
+        level.store(0xFF, std::memory_order_relaxed);
+
     m_logsTimestamp = "_" + GetTimestampStr();
     RegisterAppender<AppenderConsole>();
     RegisterAppender<AppenderFile>();
@@ -233,16 +237,74 @@ void Log::write(std::unique_ptr<LogMessage>&& msg) const
 
     if (_ioContext)
     {
-        std::shared_ptr<LogOperation> logOperation = std::make_shared<LogOperation>(logger, std::move(msg));
-        Trinity::Asio::post(*_ioContext, Trinity::Asio::bind_executor(*_strand, [logOperation]() { logOperation->call(); }));
+        bool schedule = false;
+        {
+            std::lock_guard<std::mutex> lock(_queueLock);
+            // errors are never dropped
+            if (_queueLimit && _queue.size() >= _queueLimit && msg->level < LOG_LEVEL_ERROR)
+            {
+                ++_droppedMessages;
+                return;
+            }
+
+            _queue.emplace_back(logger, std::move(msg));
+            if (!_writeScheduled)
+                schedule = _writeScheduled = true;
+        }
+
+        if (schedule)
+            Trinity::Asio::post(*_ioContext, Trinity::Asio::bind_executor(*_strand, [this]() { WriteQueued(); }));
     }
     else
+    {
         logger->write(msg.get());
+        logger->Flush();
+    }
 
     std::cout << "";
     std::cerr << "";
 }
 
+void Log::WriteQueued() const
+{
+    std::lock_guard<std::mutex> writeLock(_writeLock);
+    {
+        std::lock_guard<std::mutex> lock(_queueLock);
+        _writeQueue.swap(_queue);
+        _writeScheduled = false;
+    }
+
+    if (_writeQueue.empty())
+        return;
+
+    for (LogOperation& operation : _writeQueue)
+        operation.call();
+
+    _writtenMessages += _writeQueue.size();
+    _writeQueue.clear();
+
+    FlushAppenders();
+}
+
+void Log::FlushAppenders() const
+{
+    for (AppenderMap::const_iterator it = appenders.begin(); it != appenders.end(); ++it)
+        it->second->Flush();
+}
+
+Log::QueueStatistics Log::GetQueueStatistics() const
+{
+    QueueStatistics stats;
+    {
+        std::lock_guard<std::mutex> lock(_queueLock);
+        stats.Queued = _queue.size();
+    }
+
+    stats.Written = _writtenMessages;
+    stats.Dropped = _droppedMessages;
+    return stats;
+}
+
 std::string Log::GetTimestampStr()
 {
     time_t tt = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
@@ -279,6 +341,8 @@ bool Log::SetLogLevel(std::string const& name, const char* newLevelc, bool isLog
 
         if (newLevel != LOG_LEVEL_DISABLED && newLevel < lowestLogLevel)
             lowestLogLevel = newLevel;
+
+        UpdateFilterLevels();
     }
     else
     {
@@ -318,6 +382,9 @@ void Log::SetRealmId(uint32 id)
 
 void Log::Close()
 {
+    // queued messages still point to the loggers
+    WriteQueued();
+
     loggers.clear();
     for (AppenderMap::iterator it = appenders.begin(); it != appenders.end(); ++it)
         delete it->second;
@@ -344,6 +411,8 @@ void Log::Initialize(Trinity::Asio::IoContext* ioContext)
 
 void Log::SetSynchronous()
 {
+    WriteQueued();
+
     delete _strand;
     _strand = nullptr;
     _ioContext = nullptr;
@@ -355,6 +424,7 @@ void Log::LoadFromConfig()
 
     lowestLogLevel = LOG_LEVEL_FATAL;
     AppenderId = 0;
+    _queueLimit = std::size_t(std::max(0, sConfigMgr->GetIntDefault("Log.Async.QueueSize", 100000)));
     m_logsDir = sConfigMgr->GetStringDefault("LogsDir", "");
     if (!m_logsDir.empty())
         if ((m_logsDir.at(m_logsDir.length() - 1) != '/') && (m_logsDir.at(m_logsDir.length() - 1) != '\\'))
@@ -362,4 +432,37 @@ void Log::LoadFromConfig()
 
     ReadAppendersFromConfig();
     ReadLoggersFromConfig();
+    UpdateFilterLevels();
+}
+
+uint32 Log::GetFilterId(std::string const& type) const
+{
+    std::lock_guard<std::mutex> lock(_filterLock);
+    auto itr = _filterIds.find(type);
+    if (itr != _filterIds.end())
+        return itr->second;
+
+    uint32 id = uint32(_filterIds.size());
+    if (id >= MaxFilters)
+        return MaxFilters;
+
+    _filterLevels[id].store(GetFilterLevel(type), std::memory_order_relaxed);
+    _filterIds[type] = id;
+    return id;
+}
+
+uint8 Log::GetFilterLevel(std::string const& type) const
+{
+    Logger const* logger = GetLoggerByType(type);
+    if (!logger || logger->getLogLevel() == LOG_LEVEL_DISABLED)
+        return 0xFF;
+
+    return uint8(logger->getLogLevel());
+}
+
+void Log::UpdateFilterLevels()
+{
+    std::lock_guard<std::mutex> lock(_filterLock);
+    for (std::pair<std::string const, uint32> const& filter : _filterIds)
+        _filterLevels[filter.second].store(GetFilterLevel(filter.first), std::memory_order_relaxed);
 }
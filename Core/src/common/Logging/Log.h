@@ -25,16 +25,26 @@
 #include "StringFormat.h"
 #include "Common.h"
 #include "AsioHacksFwd.h"
+#include "LogOperation.h"
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/strand.hpp>
 
 #include <stdarg.h>
+#include <array>
+#include <atomic>
+#include <mutex>
 #include <unordered_map>
 #include <string>
 #include <memory>
+#include <vector>
 
 #define LOGGER_ROOT "root"
 
+// Messages below this level are compiled out of the TC_LOG_* macros, set with the LOG_COMPILE_LEVEL cmake option
+#ifndef TRINITY_LOG_COMPILE_LEVEL
+#define TRINITY_LOG_COMPILE_LEVEL 1
+#endif
+
 namespace Trinity
 {
     namespace Asio
@@ -52,6 +62,22 @@ class TC_COMMON_API Log
         ~Log();
 
     public:
+        static uint32 const MaxFilters = 1024;
+
+        /// Filter id of a TC_LOG_* call site, resolved on first use. 0 while unresolved.
+        struct FilterCache
+        {
+            std::atomic<uint32> Id;
+
+            constexpr FilterCache() : Id(0) { }
+        };
+
+        struct QueueStatistics
+        {
+            uint64 Queued;                  // messages waiting to be written
+            uint64 Written;                 // messages written by the asynchronous writer since startup
+            uint64 Dropped;                 // messages dropped because the queue was full
+        };
 
         static Log* instance();
 
@@ -60,6 +86,25 @@ class TC_COMMON_API Log
         void LoadFromConfig();
         void Close();
         bool ShouldLog(std::string const& type, LogLevel level) const;
+
+        // string literal filters are looked up once per call site, later checks are a single atomic load
+        template<std::size_t N>
+        bool ShouldLog(FilterCache& cache, char const (&type)[N], LogLevel level) const
+        {
+            uint32 id = cache.Id.load(std::memory_order_acquire);
+            if (!id)
+            {
+                id = GetFilterId(type) + 1;
+                cache.Id.store(id, std::memory_order_release);
+            }
+
+            if (id > MaxFilters)
+                return ShouldLog(type, level);
+
+            return uint8(level) >= _filterLevels[id - 1].load(std::memory_order_relaxed);
+        }
+
+        bool ShouldLog(FilterCache& /*cache*/, std::string const& type, LogLevel level) const { return ShouldLog(type, level); }
         bool SetLogLevel(std::string const& name, char const* level, bool isLogger = true);
 
         template<typename Format, typename... Args>
@@ -100,9 +145,16 @@ class TC_COMMON_API Log
         std::string const& GetLogsDir() const { return m_logsDir; }
         std::string const& GetLogsTimestamp() const { return m_logsTimestamp; }
 
+        QueueStatistics GetQueueStatistics() const;
+
     private:
         static std::string GetTimestampStr();
         void write(std::unique_ptr<LogMessage>&& msg) const;
+        void WriteQueued() const;
+        void FlushAppenders() const;
+        uint32 GetFilterId(std::string const& type) const;
+        uint8 GetFilterLevel(std::string const& type) const;
+        void UpdateFilterLevels();
 
         Logger const* GetLoggerByType(std::string const& type) const;
         Appender* GetAppenderByName(std::string const& name);
@@ -123,6 +175,22 @@ class TC_COMMON_API Log
 
         Trinity::Asio::IoContext* _ioContext;
         Trinity::Asio::Strand* _strand;
+
+        // messages are queued by the logging threads and written in batches on the strand,
+        // a single write is scheduled whenever the queue becomes non empty
+        mutable std::mutex _queueLock;
+        mutable std::vector<LogOperation> _queue;
+        mutable std::mutex _writeLock;
+        mutable std::vector<LogOperation> _writeQueue;     // only used by WriteQueued, swapped with _queue
+        mutable bool _writeScheduled;
+        std::size_t _queueLimit;
+        mutable std::atomic<uint64> _writtenMessages;
+        mutable std::atomic<uint64> _droppedMessages;
+
+        // lowest level logged for every filter seen by ShouldLog(FilterCache&, ...), refreshed when levels change
+        mutable std::mutex _filterLock;
+        mutable std::unordered_map<std::string, uint32> _filterIds;
+        mutable std::array<std::atomic<uint8>, MaxFilters> _filterLevels;
 };
 
 inline Logger const* Log::GetLoggerByType(std::string const& type) const
@@ -182,7 +250,9 @@ void check_args(std::string const&, ...);
 // This will catch format errors on build time
 #define TC_LOG_MESSAGE_BODY(filterType__, level__, ...)                 \
         do {                                                            \
-            if (sLog->ShouldLog(filterType__, level__))                 \
+            static Log::FilterCache tc_log_filter__;                    \
+            if (level__ >= TRINITY_LOG_COMPILE_LEVEL &&                 \
+                sLog->ShouldLog(tc_log_filter__, filterType__, level__)) \
             {                                                           \
                 if (false)                                              \
                     check_args(__VA_ARGS__);                            \
@@ -195,7 +265,9 @@ void check_args(std::string const&, ...);
         __pragma(warning(push))                                         \
         __pragma(warning(disable:4127))                                 \
         do {                                                            \
-            if (sLog->ShouldLog(filterType__, level__))                 \
+            static Log::FilterCache tc_log_filter__;                    \
+            if (level__ >= TRINITY_LOG_COMPILE_LEVEL &&                 \
+                sLog->ShouldLog(tc_log_filter__, filterType__, level__)) \
                 LOG_EXCEPTION_FREE(filterType__, level__, __VA_ARGS__); \
         } while (0)                                                     \
         __pragma(warning(pop))
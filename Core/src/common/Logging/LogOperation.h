@@ -31,6 +31,9 @@ class TC_COMMON_API LogOperation
             : logger(_logger), msg(std::forward<std::unique_ptr<LogMessage>>(_msg))
         { }
 
+        LogOperation(LogOperation&&) = default;
+        LogOperation& operator=(LogOperation&&) = default;
+
         ~LogOperation() { }
 
         int call();
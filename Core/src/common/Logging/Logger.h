@@ -33,6 +33,7 @@ class TC_COMMON_API Logger
         LogLevel getLogLevel() const;
         void setLogLevel(LogLevel level);
         void write(LogMessage* message) const;
+        void Flush() const;
 
     private:
         std::string name;
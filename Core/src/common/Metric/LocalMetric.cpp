@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2008-2016 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LocalMetric.h"
+#include <algorithm>
+
+namespace Trinity
+{
+namespace Metrics
+{
+    uint32 GetThreadShard()
+    {
+        static std::atomic<uint32> nextShard(0);
+        thread_local uint32 const shard = nextShard.fetch_add(1, std::memory_order_relaxed) % ShardCount;
+        return shard;
+    }
+
+    Counter::Counter()
+    {
+        for (Shard& shard : _shards)
+            shard.Value.store(0, std::memory_order_relaxed);
+    }
+
+    uint64 Counter::Get() const
+    {
+        uint64 value = 0;
+        for (Shard const& shard : _shards)
+            value += shard.Value.load(std::memory_order_relaxed);
+        return value;
+    }
+
+    Histogram::Histogram()
+    {
+        for (Shard& shard : _shards)
+        {
+            shard.Count.store(0, std::memory_order_relaxed);
+            shard.Sum.store(0, std::memory_order_relaxed);
+            shard.Max.store(0, std::memory_order_relaxed);
+            for (std::atomic<uint64>& bucket : shard.Buckets)
+                bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void Histogram::Record(uint64 value)
+    {
+        Shard& shard = _shards[GetThreadShard()];
+        shard.Count.fetch_add(1, std::memory_order_relaxed);
+        shard.Sum.fetch_add(value, std::memory_order_relaxed);
+        shard.Buckets[GetBucket(value)].fetch_add(1, std::memory_order_relaxed);
+
+        // shards are mostly written by a single thread, the loop rarely runs twice
+        uint64 max = shard.Max.load(std::memory_order_relaxed);
+        while (value > max && !shard.Max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+            ;
+    }
+
+    Histogram::Snapshot Histogram::GetSnapshot() const
+    {
+        Snapshot snapshot;
+        snapshot.Count = 0;
+        snapshot.Sum = 0;
+        snapshot.Max = 0;
+        snapshot.Buckets.fill(0);
+
+        for (Shard const& shard : _shards)
+        {
+            snapshot.Count += shard.Count.load(std::memory_order_relaxed);
+            snapshot.Sum += shard.Sum.load(std::memory_order_relaxed);
+            snapshot.Max = std::max(snapshot.Max, shard.Max.load(std::memory_order_relaxed));
+            for (uint32 i = 0; i < BucketCount; ++i)
+                snapshot.Buckets[i] += shard.Buckets[i].load(std::memory_order_relaxed);
+        }
+
+        return snapshot;
+    }
+
+    uint32 Histogram::GetBucket(uint64 value)
+    {
+        if (value < SubBucketCount)
+            return uint32(value);
+
+        if (value >= (uint64(1) << MaxValueBits))
+            return BucketCount - 1;
+
+        uint32 exponent = SubBucketBits;
+        while ((value >> (exponent + 1)) != 0)
+            ++exponent;
+
+        uint32 subBucket = uint32(value >> (exponent - SubBucketBits)) - SubBucketCount;
+        return (exponent - SubBucketBits + 1) * SubBucketCount + subBucket;
+    }
+
+    uint64 Histogram::GetBucketUpperBound(uint32 bucket)
+    {
+        if (bucket < SubBucketCount)
+            return bucket;
+
+        uint32 exponent = bucket / SubBucketCount + SubBucketBits - 1;
+        uint64 subBucket = bucket % SubBucketCount;
+        return ((SubBucketCount + subBucket + 1) << (exponent - SubBucketBits)) - 1;
+    }
+
+    uint64 Histogram::Snapshot::GetPercentile(double percentile) const
+    {
+        if (!Count)
+            return 0;
+
+        uint64 target = std::max<uint64>(1, uint64(double(Count) * percentile / 100.0 + 0.5));
+        uint64 seen = 0;
+        for (uint32 i = 0; i < BucketCount; ++i)
+        {
+            seen += Buckets[i];
+            if (seen >= target)
+                return std::min(GetBucketUpperBound(i), Max);
+        }
+
+        return Max;
+    }
+}
+}
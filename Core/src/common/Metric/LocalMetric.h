@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2008-2016 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOCALMETRIC_H__
+#define LOCALMETRIC_H__
+
+#include "Define.h"
+#include <array>
+#include <atomic>
+
+/*
+ * Counters, gauges and latency histograms kept in process memory.
+ * Writers update one of a few shards picked per thread with relaxed atomics,
+ * readers merge the shards. Nothing is formatted or allocated when recording.
+ */
+namespace Trinity
+{
+namespace Metrics
+{
+    static uint32 const ShardCount = 8;
+
+    TC_COMMON_API uint32 GetThreadShard();
+
+    class TC_COMMON_API Counter
+    {
+    public:
+        Counter();
+
+        void Add(uint64 value = 1) { _shards[GetThreadShard()].Value.fetch_add(value, std::memory_order_relaxed); }
+        uint64 Get() const;
+
+    private:
+        struct alignas(64) Shard
+        {
+            std::atomic<uint64> Value;
+        };
+
+        std::array<Shard, ShardCount> _shards;
+    };
+
+    class TC_COMMON_API Gauge
+    {
+    public:
+        Gauge() : _value(0) { }
+
+        void Set(int64 value) { _value.store(value, std::memory_order_relaxed); }
+        int64 Get() const { return _value.load(std::memory_order_relaxed); }
+
+    private:
+        std::atomic<int64> _value;
+    };
+
+    /// Log-linear buckets with 16 sub buckets per power of two (about 6% precision), values up to 2^40
+    class TC_COMMON_API Histogram
+    {
+    public:
+        static uint32 const SubBucketBits = 4;
+        static uint32 const SubBucketCount = 1 << SubBucketBits;
+        static uint32 const MaxValueBits = 40;
+        static uint32 const BucketCount = (MaxValueBits - SubBucketBits + 1) * SubBucketCount;
+
+        struct Snapshot
+        {
+            uint64 Count;
+            uint64 Sum;
+            uint64 Max;
+            std::array<uint64, BucketCount> Buckets;
+
+            /// Upper bound of the bucket holding the given percentile (0-100)
+            uint64 GetPercentile(double percentile) const;
+        };
+
+        Histogram();
+
+        void Record(uint64 value);
+        Snapshot GetSnapshot() const;
+
+        static uint32 GetBucket(uint64 value);
+        static uint64 GetBucketUpperBound(uint32 bucket);
+
+    private:
+        struct alignas(64) Shard
+        {
+            std::atomic<uint64> Count;
+            std::atomic<uint64> Sum;
+            std::atomic<uint64> Max;
+            std::array<std::atomic<uint64>, BucketCount> Buckets;
+        };
+
+        std::array<Shard, ShardCount> _shards;
+    };
+}
+}
+
+#endif // LOCALMETRIC_H__
@@ -24,6 +24,7 @@
 #include "Util.h"
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/asio/ip/tcp.hpp>
+#include <cstdio>
 
 void Metric::Initialize(std::string const& realmName, Trinity::Asio::IoContext& ioContext, std::function<void()> overallStatusLogger)
 {
@@ -31,6 +32,7 @@ void Metric::Initialize(std::string const& realmName, Trinity::Asio::IoContext&
     _realmName = FormatInfluxDBTagValue(realmName);
     _batchTimer = std::make_unique<Trinity::Asio::DeadlineTimer>(ioContext);
     _overallStatusTimer = std::make_unique<Trinity::Asio::DeadlineTimer>(ioContext);
+    _dumpTimer = std::make_unique<Trinity::Asio::DeadlineTimer>(ioContext);
     _overallStatusLogger = overallStatusLogger;
     LoadFromConfigs();
 }
@@ -53,6 +55,20 @@ bool Metric::Connect()
 
 void Metric::LoadFromConfigs()
 {
+    bool previousDump = !_dumpFile.empty();
+    _dumpFile = sConfigMgr->GetStringDefault("Metric.Dump.File", "");
+    _dumpInterval = sConfigMgr->GetIntDefault("Metric.Dump.Interval", 60);
+    if (_dumpInterval < 1)
+    {
+        TC_LOG_ERROR("metric", "'Metric.Dump.Interval' config set to %d, overriding to 1.", _dumpInterval);
+        _dumpInterval = 1;
+    }
+
+    if (!_dumpFile.empty() && !previousDump)
+        ScheduleDump();
+    else if (_dumpFile.empty() && previousDump)
+        _dumpTimer->cancel();
+
     bool previousValue = _enabled;
     _enabled = sConfigMgr->GetBoolDefault("Metric.Enable", false);
     _updateInterval = sConfigMgr->GetIntDefault("Metric.Interval", 10);
@@ -216,8 +232,115 @@ void Metric::ScheduleSend()
 void Metric::ForceSend()
 {
     // Send what's queued only if IoContext is stopped (so only on shutdown)
-    if (_enabled && Trinity::Asio::get_io_context(*_batchTimer).stopped())
+    if (!Trinity::Asio::get_io_context(*_batchTimer).stopped())
+        return;
+
+    if (_enabled)
         SendBatch();
+
+    if (!_dumpFile.empty())
+        DumpLocalMetrics();
+}
+
+void Metric::ScheduleDump()
+{
+    if (_dumpFile.empty())
+        return;
+
+    _dumpTimer->expires_from_now(Seconds(_dumpInterval));
+    _dumpTimer->async_wait([this](boost::system::error_code const& error)
+    {
+        // the dump may have been disabled by a config reload while waiting
+        if (error || _dumpFile.empty())
+            return;
+
+        DumpLocalMetrics();
+        ScheduleDump();
+    });
+}
+
+Trinity::Metrics::Counter& Metric::GetCounter(std::string const& name)
+{
+    std::lock_guard<std::mutex> lock(_localMetricsLock);
+    std::unique_ptr<Trinity::Metrics::Counter>& counter = _counters[name];
+    if (!counter)
+        counter = std::make_unique<Trinity::Metrics::Counter>();
+    return *counter;
+}
+
+Trinity::Metrics::Gauge& Metric::GetGauge(std::string const& name)
+{
+    std::lock_guard<std::mutex> lock(_localMetricsLock);
+    std::unique_ptr<Trinity::Metrics::Gauge>& gauge = _gauges[name];
+    if (!gauge)
+        gauge = std::make_unique<Trinity::Metrics::Gauge>();
+    return *gauge;
+}
+
+Trinity::Metrics::Histogram& Metric::GetHistogram(std::string const& name)
+{
+    std::lock_guard<std::mutex> lock(_localMetricsLock);
+    std::unique_ptr<Trinity::Metrics::Histogram>& histogram = _histograms[name];
+    if (!histogram)
+        histogram = std::make_unique<Trinity::Metrics::Histogram>();
+    return *histogram;
+}
+
+std::string Metric::FormatLocalMetrics()
+{
+    std::ostringstream ss;
+    ss << "# realm " << _realmName << " at " << TimeToTimestampStr(time(nullptr)) << "\n";
+
+    std::lock_guard<std::mutex> lock(_localMetricsLock);
+    for (auto const& counter : _counters)
+        ss << "counter " << counter.first << ' ' << counter.second->Get() << "\n";
+
+    for (auto const& gauge : _gauges)
+        ss << "gauge " << gauge.first << ' ' << gauge.second->Get() << "\n";
+
+    for (auto const& histogram : _histograms)
+    {
+        Trinity::Metrics::Histogram::Snapshot snapshot = histogram.second->GetSnapshot();
+        ss << "histogram " << histogram.first
+            << " count=" << snapshot.Count
+            << " mean=" << (snapshot.Count ? snapshot.Sum / snapshot.Count : 0)
+            << " p50=" << snapshot.GetPercentile(50.0)
+            << " p90=" << snapshot.GetPercentile(90.0)
+            << " p99=" << snapshot.GetPercentile(99.0)
+            << " p99.9=" << snapshot.GetPercentile(99.9)
+            << " max=" << snapshot.Max << "\n";
+    }
+
+    return ss.str();
+}
+
+bool Metric::DumpLocalMetrics()
+{
+    std::string data = FormatLocalMetrics();
+
+    // written next to the target and renamed, readers never see a partial file
+    std::string tempFile = _dumpFile + ".tmp";
+    FILE* file = fopen(tempFile.c_str(), "w");
+    if (!file)
+    {
+        TC_LOG_ERROR("metric", "Could not open '%s' to dump local metrics.", tempFile.c_str());
+        return false;
+    }
+
+    bool written = fwrite(data.c_str(), 1, data.size(), file) == data.size();
+    fclose(file);
+
+#if PLATFORM == PLATFORM_WINDOWS
+    // rename does not replace an existing file on Windows, readers may briefly miss the file there
+    std::remove(_dumpFile.c_str());
+#endif
+    if (!written || std::rename(tempFile.c_str(), _dumpFile.c_str()) != 0)
+    {
+        TC_LOG_ERROR("metric", "Could not write local metrics to '%s'.", _dumpFile.c_str());
+        return false;
+    }
+
+    return true;
 }
 
 void Metric::ScheduleOverallStatusLog()
@@ -20,11 +20,14 @@
 #define METRIC_H__
 
 #include "Define.h"
+#include "LocalMetric.h"
 #include "MPSCQueue.h"
 #include <chrono>
 #include <functional>
 #include <iosfwd>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 
 namespace Trinity
@@ -74,10 +77,20 @@ private:
     std::function<void()> _overallStatusLogger;
     std::string _realmName;
 
+    // in-process counters, gauges and histograms, recorded even when the InfluxDB export is disabled
+    std::mutex _localMetricsLock;
+    std::map<std::string, std::unique_ptr<Trinity::Metrics::Counter>> _counters;
+    std::map<std::string, std::unique_ptr<Trinity::Metrics::Gauge>> _gauges;
+    std::map<std::string, std::unique_ptr<Trinity::Metrics::Histogram>> _histograms;
+    std::unique_ptr<Trinity::Asio::DeadlineTimer> _dumpTimer;
+    std::string _dumpFile;
+    int32 _dumpInterval = 0;
+
     bool Connect();
     void SendBatch();
     void ScheduleSend();
     void ScheduleOverallStatusLog();
+    void ScheduleDump();
 
     static std::string FormatInfluxDBValue(bool value);
     template <class T>
@@ -118,6 +131,16 @@ public:
 
     void ForceSend();
     bool IsEnabled() const { return _enabled; }
+
+    // The returned references stay valid until shutdown, call sites are expected to cache them
+    Trinity::Metrics::Counter& GetCounter(std::string const& name);
+    Trinity::Metrics::Gauge& GetGauge(std::string const& name);
+    Trinity::Metrics::Histogram& GetHistogram(std::string const& name);
+
+    /// Text report of all local metrics, histograms are summarized by percentiles
+    std::string FormatLocalMetrics();
+    /// Writes FormatLocalMetrics() to Metric.Dump.File
+    bool DumpLocalMetrics();
 };
 
 #define sMetric Metric::instance()
@@ -133,6 +156,21 @@ public:
             if (sMetric->IsEnabled())                              \
                 sMetric->LogValue(category, value);                \
         } while (0)
+#define TC_METRIC_COUNTER(name, value)                                  \
+        do {                                                            \
+            static Trinity::Metrics::Counter& tc_metric__ = sMetric->GetCounter(name); \
+            tc_metric__.Add(value);                                     \
+        } while (0)
+#define TC_METRIC_GAUGE(name, value)                                    \
+        do {                                                            \
+            static Trinity::Metrics::Gauge& tc_metric__ = sMetric->GetGauge(name); \
+            tc_metric__.Set(value);                                     \
+        } while (0)
+#define TC_METRIC_HISTOGRAM(name, value)                                \
+        do {                                                            \
+            static Trinity::Metrics::Histogram& tc_metric__ = sMetric->GetHistogram(name); \
+            tc_metric__.Record(value);                                  \
+        } while (0)
 #else
 #define TC_METRIC_EVENT(category, title, description)                    \
         __pragma(warning(push))                                         \
@@ -150,6 +188,30 @@ public:
                 sMetric->LogValue(category, value);                \
         } while (0)                                                     \
         __pragma(warning(pop))
+#define TC_METRIC_COUNTER(name, value)                                  \
+        __pragma(warning(push))                                         \
+        __pragma(warning(disable:4127))                                 \
+        do {                                                            \
+            static Trinity::Metrics::Counter& tc_metric__ = sMetric->GetCounter(name); \
+            tc_metric__.Add(value);                                     \
+        } while (0)                                                     \
+        __pragma(warning(pop))
+#define TC_METRIC_GAUGE(name, value)                                    \
+        __pragma(warning(push))                                         \
+        __pragma(warning(disable:4127))                                 \
+        do {                                                            \
+            static Trinity::Metrics::Gauge& tc_metric__ = sMetric->GetGauge(name); \
+            tc_metric__.Set(value);                                     \
+        } while (0)                                                     \
+        __pragma(warning(pop))
+#define TC_METRIC_HISTOGRAM(name, value)                                \
+        __pragma(warning(push))                                         \
+        __pragma(warning(disable:4127))                                 \
+        do {                                                            \
+            static Trinity::Metrics::Histogram& tc_metric__ = sMetric->GetHistogram(name); \
+            tc_metric__.Record(value);                                  \
+        } while (0)                                                     \
+        __pragma(warning(pop))
 #endif
 
 #endif // METRIC_H__
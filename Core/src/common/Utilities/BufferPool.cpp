@@ -0,0 +1,306 @@
+/*
+ * Copyright (C) 2008-2016 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BufferPool.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <new>
+
+namespace
+{
+    std::size_t const StorageClassSizes[BufferPool::SIZE_CLASS_COUNT] = { 256, 1024, 4096, 16384, 65536, 262144 };
+    std::size_t const BlockSize = 128;                  // fits WorldPacket and the packets derived from it
+    std::size_t const MagazineSize = 32;                        // max buffers moved between a thread cache and the depot at once
+    std::size_t const DepotBudget = 8 * 1024 * 1024;            // bytes kept in the depot per size class
+    std::size_t const ThreadClassBudget = 1024 * 1024;          // bytes kept by a thread per size class
+    std::size_t const ThreadBudget = 4 * 1024 * 1024;           // bytes of storage kept by a thread in all size classes
+
+    // buffers a thread keeps per size class, big classes keep fewer
+    std::size_t GetLocalLimit(uint32 sizeClass)
+    {
+        return std::min(MagazineSize, std::max<std::size_t>(1, ThreadClassBudget / StorageClassSizes[sizeClass]));
+    }
+
+    std::size_t GetBytes(std::vector<std::vector<uint8>> const& magazine)
+    {
+        std::size_t bytes = 0;
+        for (std::vector<uint8> const& storage : magazine)
+            bytes += storage.capacity();
+        return bytes;
+    }
+
+    std::size_t GetBytes(std::vector<void*> const& magazine)
+    {
+        return magazine.size() * BlockSize;
+    }
+
+    template<class T>
+    struct Depot
+    {
+        std::mutex Lock;
+        std::vector<std::vector<T>> Magazines;
+        std::size_t Bytes = 0;
+    };
+
+    struct Counters
+    {
+        std::atomic<uint64> Hits;
+        std::atomic<uint64> Misses;
+        std::atomic<uint64> Released;
+        std::atomic<uint64> Dropped;
+
+        Counters() : Hits(0), Misses(0), Released(0), Dropped(0) { }
+
+        BufferPool::Statistics Get() const
+        {
+            BufferPool::Statistics stats;
+            stats.Hits = Hits.load(std::memory_order_relaxed);
+            stats.Misses = Misses.load(std::memory_order_relaxed);
+            stats.Released = Released.load(std::memory_order_relaxed);
+            stats.Dropped = Dropped.load(std::memory_order_relaxed);
+            return stats;
+        }
+    };
+
+    struct Pools
+    {
+        Depot<std::vector<uint8>> Storage[BufferPool::SIZE_CLASS_COUNT];
+        Depot<void*> Blocks;
+        Counters StorageCounters;
+        Counters BlockCounters;
+
+    };
+
+    // never destroyed, packets may still be freed during static destruction
+    Pools& GetPools()
+    {
+        static Pools* pools = new Pools();
+        return *pools;
+    }
+
+    struct ThreadCache
+    {
+        std::vector<std::vector<uint8>> Storage[BufferPool::SIZE_CLASS_COUNT];
+        std::size_t StorageBytes = 0;                   // capacity of all buffers in Storage
+        std::vector<void*> Blocks;
+
+        ~ThreadCache();
+    };
+
+    thread_local bool ThreadCacheDestroyed = false;
+    thread_local ThreadCache LocalCache;
+
+    ThreadCache::~ThreadCache()
+    {
+        ThreadCacheDestroyed = true;
+        for (void* block : Blocks)
+            ::operator delete(block);
+    }
+
+    // local must be empty, returns the bytes moved into it
+    template<class T>
+    std::size_t TakeMagazine(Depot<T>& depot, std::vector<T>& local)
+    {
+        std::lock_guard<std::mutex> lock(depot.Lock);
+        if (depot.Magazines.empty())
+            return 0;
+
+        local.swap(depot.Magazines.back());
+        depot.Magazines.pop_back();
+
+        std::size_t bytes = GetBytes(local);
+        depot.Bytes -= bytes;
+        return bytes;
+    }
+
+    // returns the bytes moved out of local, 0 if the depot is full
+    template<class T>
+    std::size_t GiveMagazine(Depot<T>& depot, std::vector<T>& local)
+    {
+        std::size_t bytes = GetBytes(local);
+        {
+            std::lock_guard<std::mutex> lock(depot.Lock);
+            if (depot.Bytes + bytes > DepotBudget)
+                return 0;
+
+            depot.Magazines.push_back(std::move(local));
+            depot.Bytes += bytes;
+        }
+
+        local = std::vector<T>();
+        local.reserve(MagazineSize);
+        return bytes;
+    }
+
+    // smallest class that can hold `size` bytes, SIZE_CLASS_COUNT if none
+    uint32 GetAcquireClass(std::size_t size)
+    {
+        uint32 i = 0;
+        while (i < BufferPool::SIZE_CLASS_COUNT && StorageClassSizes[i] < size)
+            ++i;
+        return i;
+    }
+
+    // largest class not bigger than `capacity`, SIZE_CLASS_COUNT if none or if the buffer grew past the largest class
+    uint32 GetReleaseClass(std::size_t capacity)
+    {
+        if (capacity < StorageClassSizes[0] || capacity > StorageClassSizes[BufferPool::SIZE_CLASS_COUNT - 1])
+            return BufferPool::SIZE_CLASS_COUNT;
+
+        uint32 i = BufferPool::SIZE_CLASS_COUNT - 1;
+        while (StorageClassSizes[i] > capacity)
+            --i;
+        return i;
+    }
+}
+
+void BufferPool::Acquire(std::vector<uint8>& storage, std::size_t capacity)
+{
+    storage.clear();
+    if (storage.capacity() >= capacity)
+        return;
+
+    Pools& pools = GetPools();
+    uint32 sizeClass = GetAcquireClass(capacity);
+    if (sizeClass == SIZE_CLASS_COUNT)
+    {
+        pools.StorageCounters.Misses.fetch_add(1, std::memory_order_relaxed);
+        storage.reserve(capacity);
+        return;
+    }
+
+    if (!ThreadCacheDestroyed)
+    {
+        std::vector<std::vector<uint8>>& local = LocalCache.Storage[sizeClass];
+        if (local.empty())
+            LocalCache.StorageBytes += TakeMagazine(pools.Storage[sizeClass], local);
+
+        if (!local.empty())
+        {
+            std::vector<uint8> old;
+            old.swap(storage);
+            storage.swap(local.back());
+            local.pop_back();
+            LocalCache.StorageBytes -= storage.capacity();
+            Release(old);
+
+            pools.StorageCounters.Hits.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    pools.StorageCounters.Misses.fetch_add(1, std::memory_order_relaxed);
+    // round up to the size class so the buffer can go back to the same class
+    storage.reserve(StorageClassSizes[sizeClass]);
+}
+
+void BufferPool::Release(std::vector<uint8>& storage)
+{
+    if (!storage.capacity())
+        return;
+
+    Pools& pools = GetPools();
+    uint32 sizeClass = GetReleaseClass(storage.capacity());
+    if (sizeClass == SIZE_CLASS_COUNT || ThreadCacheDestroyed)
+    {
+        pools.StorageCounters.Dropped.fetch_add(1, std::memory_order_relaxed);
+        std::vector<uint8>().swap(storage);
+        return;
+    }
+
+    // hand the class cache to the depot when it is full or the thread keeps too much memory
+    std::vector<std::vector<uint8>>& local = LocalCache.Storage[sizeClass];
+    if (local.size() >= GetLocalLimit(sizeClass) || (!local.empty() && LocalCache.StorageBytes + storage.capacity() > ThreadBudget))
+        LocalCache.StorageBytes -= GiveMagazine(pools.Storage[sizeClass], local);
+
+    if (local.size() >= GetLocalLimit(sizeClass) || LocalCache.StorageBytes + storage.capacity() > ThreadBudget)
+    {
+        pools.StorageCounters.Dropped.fetch_add(1, std::memory_order_relaxed);
+        std::vector<uint8>().swap(storage);
+        return;
+    }
+
+    storage.clear();
+    LocalCache.StorageBytes += storage.capacity();
+    local.push_back(std::move(storage));
+    storage = std::vector<uint8>();
+    pools.StorageCounters.Released.fetch_add(1, std::memory_order_relaxed);
+}
+
+void* BufferPool::AllocateBlock(std::size_t size)
+{
+    if (size > BlockSize)
+        return ::operator new(size);
+
+    Pools& pools = GetPools();
+    if (!ThreadCacheDestroyed)
+    {
+        std::vector<void*>& local = LocalCache.Blocks;
+        if (!local.empty() || TakeMagazine(pools.Blocks, local) != 0)
+        {
+            void* block = local.back();
+            local.pop_back();
+            pools.BlockCounters.Hits.fetch_add(1, std::memory_order_relaxed);
+            return block;
+        }
+    }
+
+    pools.BlockCounters.Misses.fetch_add(1, std::memory_order_relaxed);
+    return ::operator new(BlockSize);
+}
+
+void BufferPool::FreeBlock(void* block, std::size_t size)
+{
+    if (!block)
+        return;
+
+    if (size > BlockSize)
+    {
+        ::operator delete(block);
+        return;
+    }
+
+    Pools& pools = GetPools();
+    if (ThreadCacheDestroyed)
+    {
+        pools.BlockCounters.Dropped.fetch_add(1, std::memory_order_relaxed);
+        ::operator delete(block);
+        return;
+    }
+
+    std::vector<void*>& local = LocalCache.Blocks;
+    if (local.size() >= MagazineSize && GiveMagazine(pools.Blocks, local) == 0)
+    {
+        pools.BlockCounters.Dropped.fetch_add(1, std::memory_order_relaxed);
+        ::operator delete(block);
+        return;
+    }
+
+    local.push_back(block);
+    pools.BlockCounters.Released.fetch_add(1, std::memory_order_relaxed);
+}
+
+BufferPool::Statistics BufferPool::GetStorageStatistics()
+{
+    return GetPools().StorageCounters.Get();
+}
+
+BufferPool::Statistics BufferPool::GetBlockStatistics()
+{
+    return GetPools().BlockCounters.Get();
+}
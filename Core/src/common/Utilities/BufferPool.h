@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2008-2016 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BufferPool_h__
+#define BufferPool_h__
+
+#include "Define.h"
+#include <vector>
+
+/*
+ * Recycles packet storage and packet objects instead of returning them to the heap.
+ * Every thread keeps a small cache per size class and exchanges full/empty batches
+ * with a shared depot, so buffers allocated by network threads and released by
+ * map/world threads are reused without taking a lock per buffer.
+ * Memory kept per thread and per depot class is capped, buffers beyond that or
+ * bigger than the largest class are freed.
+ */
+namespace BufferPool
+{
+    enum
+    {
+        SIZE_CLASS_COUNT = 6
+    };
+
+    struct Statistics
+    {
+        uint64 Hits;            // requests served from the pool
+        uint64 Misses;          // requests that had to allocate
+        uint64 Released;        // buffers given back to the pool
+        uint64 Dropped;         // buffers freed because the pool was full or they were too big
+    };
+
+    // Makes storage empty with capacity of at least `capacity`, reusing a pooled buffer when possible
+    TC_COMMON_API void Acquire(std::vector<uint8>& storage, std::size_t capacity);
+
+    // Takes the memory of storage into the pool, storage is left empty without capacity
+    TC_COMMON_API void Release(std::vector<uint8>& storage);
+
+    // Fixed size blocks for heap allocated packet objects
+    TC_COMMON_API void* AllocateBlock(std::size_t size);
+    TC_COMMON_API void FreeBlock(void* block, std::size_t size);
+
+    TC_COMMON_API Statistics GetStorageStatistics();
+    TC_COMMON_API Statistics GetBlockStatistics();
+}
+
+#endif // BufferPool_h__
@@ -19,6 +19,7 @@
 #define __MESSAGEBUFFER_H_
 
 #include "Define.h"
+#include "BufferPool.h"
 #include <vector>
 #include <cstring>
 
@@ -51,6 +52,10 @@ public:
 
     void Resize(size_type bytes)
     {
+        // storage was moved into a packet, take a recycled buffer instead of a new allocation
+        if (_storage.empty() && _storage.capacity() < bytes)
+            BufferPool::Acquire(_storage, bytes);
+
         _storage.resize(bytes);
     }
 
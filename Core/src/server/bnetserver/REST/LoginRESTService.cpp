@@ -97,6 +97,7 @@ bool LoginRESTService::Start(Trinity::Asio::IoContext* ioContext)
     input->set_label("Log In");
 
     _loginTicketDuration = sConfigMgr->GetIntDefault("LoginREST.TicketDuration", 3600);
+    _characterCacheDuration = sConfigMgr->GetIntDefault("LoginREST.AccountCacheDuration", 30);
 
     _thread = std::thread(std::bind(&LoginRESTService::Run, this));
     return true;
@@ -159,17 +160,18 @@ void LoginRESTService::Run()
             continue;   // ran into an accept timeout
 
         std::shared_ptr<soap> soapClient = std::make_shared<soap>(soapServer);
-        boost::asio::ip::address_v4 address(soapClient->ip);
-        if (soap_ssl_accept(soapClient.get()) != SOAP_OK)
-        {
-            TC_LOG_DEBUG("server.rest", "Failed SSL handshake from IP=%s", address.to_string().c_str());
-            continue;
-        }
-
-        TC_LOG_DEBUG("server.rest", "Accepted connection from IP=%s", address.to_string().c_str());
 
+        // the handshake is done by the connection thread, a slow client must not hold up the accept loop
         std::thread([soapClient]
         {
+            boost::asio::ip::address_v4 address(soapClient->ip);
+            if (soap_ssl_accept(soapClient.get()) != SOAP_OK)
+            {
+                TC_LOG_DEBUG("server.rest", "Failed SSL handshake from IP=%s", address.to_string().c_str());
+                return;
+            }
+
+            TC_LOG_DEBUG("server.rest", "Accepted connection from IP=%s", address.to_string().c_str());
             soap_serve(soapClient.get());
         }).detach();
     }
@@ -241,14 +243,37 @@ int32 LoginRESTService::HandlePost(soap* soapClient)
     Utf8ToUpperOnlyLatin(login);
     Utf8ToUpperOnlyLatin(password);
 
+    std::string passHash = CalculateShaPassHash(login, std::move(password));
+    std::unique_ptr<Battlenet::Session::AccountInfo> accountInfo = LoadAccountInfo(login, passHash);
+    if (accountInfo)
+    {
+        BigNumber ticket;
+        ticket.SetRand(20 * 8);
+
+        loginResult.set_login_ticket("TC-" + ByteArrayToHexStr(ticket.AsByteArray(20).get(), 20));
+
+        AddLoginTicket(loginResult.login_ticket(), std::move(accountInfo));
+    }
+
+    loginResult.set_authentication_state(Battlenet::JSON::Login::DONE);
+    return SendResponse(soapClient, loginResult);
+}
+
+std::unique_ptr<Battlenet::Session::AccountInfo> LoginRESTService::LoadAccountInfo(std::string const& login, std::string const& passHash)
+{
+    std::unique_ptr<Battlenet::Session::AccountInfo> accountInfo;
+
     PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_BNET_ACCOUNT_INFO);
     stmt->setString(0, login);
-    stmt->setString(1, CalculateShaPassHash(login, std::move(password)));
+    stmt->setString(1, passHash);
     if (PreparedQueryResult result = LoginDatabase.Query(stmt))
     {
-        std::unique_ptr<Battlenet::Session::AccountInfo> accountInfo = Trinity::make_unique<Battlenet::Session::AccountInfo>();
+        accountInfo = Trinity::make_unique<Battlenet::Session::AccountInfo>();
         accountInfo->LoadResult(result);
 
+        if (GetCachedCharacters(*accountInfo))
+            return accountInfo;
+
         stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_BNET_CHARACTER_COUNTS_BY_BNET_ID);
         stmt->setUInt32(0, accountInfo->Id);
         if (PreparedQueryResult characterCountsResult = LoginDatabase.Query(stmt))
@@ -277,16 +302,69 @@ int32 LoginRESTService::HandlePost(soap* soapClient)
             lastPlayedCharacter.LastPlayedTime = fields[6].GetUInt32();
         }
 
-        BigNumber ticket;
-        ticket.SetRand(20 * 8);
+        CacheCharacters(*accountInfo);
+    }
 
-        loginResult.set_login_ticket("TC-" + ByteArrayToHexStr(ticket.AsByteArray(20).get(), 20));
+    return accountInfo;
+}
 
-        AddLoginTicket(loginResult.login_ticket(), std::move(accountInfo));
+bool LoginRESTService::GetCachedCharacters(Battlenet::Session::AccountInfo& accountInfo)
+{
+    if (!_characterCacheDuration)
+        return false;
+
+    std::unique_lock<std::mutex> lock(_characterCacheMutex);
+    auto itr = _characterCache.find(accountInfo.Id);
+    if (itr == _characterCache.end())
+        return false;
+
+    if (itr->second.ExpiryTime <= time(nullptr))
+    {
+        _characterCache.erase(itr);
+        return false;
     }
 
-    loginResult.set_authentication_state(Battlenet::JSON::Login::DONE);
-    return SendResponse(soapClient, loginResult);
+    for (auto const& gameAccount : itr->second.GameAccounts)
+    {
+        Battlenet::Session::GameAccountInfo& gameAccountInfo = accountInfo.GameAccounts[gameAccount.first];
+        gameAccountInfo.CharacterCounts = gameAccount.second.CharacterCounts;
+        gameAccountInfo.LastPlayedCharacters = gameAccount.second.LastPlayedCharacters;
+    }
+
+    return true;
+}
+
+void LoginRESTService::CacheCharacters(Battlenet::Session::AccountInfo const& accountInfo)
+{
+    if (!_characterCacheDuration)
+        return;
+
+    CachedCharacters characters;
+    for (auto const& gameAccount : accountInfo.GameAccounts)
+    {
+        CachedCharacters::GameAccountCharacters& gameAccountCharacters = characters.GameAccounts[gameAccount.first];
+        gameAccountCharacters.CharacterCounts = gameAccount.second.CharacterCounts;
+        gameAccountCharacters.LastPlayedCharacters = gameAccount.second.LastPlayedCharacters;
+    }
+
+    std::time_t now = time(nullptr);
+    characters.ExpiryTime = now + _characterCacheDuration;
+
+    std::unique_lock<std::mutex> lock(_characterCacheMutex);
+    if (now >= _nextCharacterCachePurge)
+    {
+        for (auto itr = _characterCache.begin(); itr != _characterCache.end();)
+        {
+            if (itr->second.ExpiryTime <= now)
+                itr = _characterCache.erase(itr);
+            else
+                ++itr;
+        }
+
+        _nextCharacterCachePurge = now + _characterCacheDuration;
+    }
+
+    _characterCache[accountInfo.Id] = std::move(characters);
 }
 
 int32 LoginRESTService::SendResponse(soap* soapClient, google::protobuf::Message const& response)
@@ -36,7 +36,7 @@ struct soap_plugin;
 class LoginRESTService
 {
 public:
-    LoginRESTService() : _ioContext(nullptr), _stopped(false), _port(0), _loginTicketDuration(0) {}
+    LoginRESTService() : _ioContext(nullptr), _stopped(false), _port(0), _loginTicketDuration(0), _characterCacheDuration(0), _nextCharacterCachePurge(0) {}
 
     static LoginRESTService& Instance();
 
@@ -60,6 +60,10 @@ private:
 
     std::string CalculateShaPassHash(std::string const& name, std::string const& password);
 
+    std::unique_ptr<Battlenet::Session::AccountInfo> LoadAccountInfo(std::string const& login, std::string const& passHash);
+    bool GetCachedCharacters(Battlenet::Session::AccountInfo& accountInfo);
+    void CacheCharacters(Battlenet::Session::AccountInfo const& accountInfo);
+
     void AddLoginTicket(std::string const& id, std::unique_ptr<Battlenet::Session::AccountInfo> accountInfo);
 
     struct LoginTicket
@@ -71,6 +75,20 @@ private:
         std::time_t ExpiryTime;
     };
 
+    // character counts and last played characters of all game accounts of a battlenet account, keyed by its id
+    // credentials and bans are never cached, only these per realm queries are skipped on reconnect
+    struct CachedCharacters
+    {
+        struct GameAccountCharacters
+        {
+            std::unordered_map<uint32 /*realmAddress*/, uint8> CharacterCounts;
+            std::unordered_map<std::string /*subRegion*/, Battlenet::Session::LastPlayedCharacterInfo> LastPlayedCharacters;
+        };
+
+        std::unordered_map<uint32 /*gameAccountId*/, GameAccountCharacters> GameAccounts;
+        std::time_t ExpiryTime;
+    };
+
     struct ResponseCodePlugin
     {
         static char const* const PluginId;
@@ -104,6 +122,10 @@ private:
     std::mutex _loginTicketMutex;
     std::unordered_map<std::string, LoginTicket> _validLoginTickets;
     uint32 _loginTicketDuration;
+    std::mutex _characterCacheMutex;
+    std::unordered_map<uint32 /*accountId*/, CachedCharacters> _characterCache;
+    uint32 _characterCacheDuration;
+    std::time_t _nextCharacterCachePurge;
 };
 
 #define sLoginService LoginRESTService::Instance()
@@ -18,6 +18,8 @@
 #include "SslContext.h"
 #include "Log.h"
 #include "Config.h"
+#include <openssl/ssl.h>
+#include <algorithm>
 
 bool Battlenet::SslContext::Initialize()
 {
@@ -39,6 +41,21 @@ bool Battlenet::SslContext::Initialize()
 
 #undef LOAD_CHECK
 
+    // Let clients reconnecting after a worldserver restart resume their TLS session instead of a full handshake,
+    // shared by the bnet sessions and the login REST service
+    SSL_CTX* nativeContext = instance().native_handle();
+    int32 sessionCacheSize = sConfigMgr->GetIntDefault("SslSessionCache.Size", 20480);
+    if (sessionCacheSize > 0)
+    {
+        static unsigned char const sessionIdContext[] = "bnetserver";
+        SSL_CTX_set_session_cache_mode(nativeContext, SSL_SESS_CACHE_SERVER);
+        SSL_CTX_set_session_id_context(nativeContext, sessionIdContext, sizeof(sessionIdContext) - 1);
+        SSL_CTX_sess_set_cache_size(nativeContext, sessionCacheSize);
+        SSL_CTX_set_timeout(nativeContext, std::max(sConfigMgr->GetIntDefault("SslSessionCache.Timeout", 3600), 1));
+    }
+    else
+        SSL_CTX_set_session_cache_mode(nativeContext, SSL_SESS_CACHE_OFF);
+
     return true;
 }
 
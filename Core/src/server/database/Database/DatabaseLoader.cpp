@@ -51,7 +51,15 @@ DatabaseLoader& DatabaseLoader::AddDatabase(DatabaseWorkerPool<T>& pool, std::st
 
         uint8 const synchThreads = uint8(sConfigMgr->GetIntDefault(name + "Database.SynchThreads", 1));
 
-        pool.SetConnectionInfo(dbString, asyncThreads, synchThreads);
+        uint32 const batchSize = uint32(sConfigMgr->GetIntDefault(name + "Database.BatchSize", 1));
+        if (batchSize < 1 || batchSize > 1000)
+        {
+            TC_LOG_ERROR(_logger, "%s database: invalid batch size specified. "
+                "Please pick a value between 1 and 1000.", name.c_str());
+            return false;
+        }
+
+        pool.SetConnectionInfo(dbString, asyncThreads, synchThreads, batchSize);
         if (uint32 error = pool.Open())
         {
             // Database does not exist
@@ -20,12 +20,22 @@
 #include "SQLOperation.h"
 #include "MySQLConnection.h"
 #include "MySQLThreading.h"
+#include "Metric.h"
 #include "ProducerConsumerQueue.h"
 
-DatabaseWorker::DatabaseWorker(ProducerConsumerQueue<SQLOperation*>* newQueue, MySQLConnection* connection)
+namespace
+{
+    void RecordQueueLatency(SQLOperation const* operation)
+    {
+        TC_METRIC_HISTOGRAM("db_queue_latency_us", uint64(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - operation->m_queueTime).count()));
+    }
+}
+
+DatabaseWorker::DatabaseWorker(ProducerConsumerQueue<SQLOperation*>* newQueue, MySQLConnection* connection, uint32 batchSize /*= 1*/)
 {
     _connection = connection;
     _queue = newQueue;
+    _batchSize = std::max(batchSize, 1u);
     _cancelationToken = false;
     _workerThread = std::thread(&DatabaseWorker::WorkerThread, this);
 }
@@ -44,6 +54,9 @@ void DatabaseWorker::WorkerThread()
     if (!_queue)
         return;
 
+    std::vector<SQLOperation*> batch;
+    batch.reserve(_batchSize);
+
     for (;;)
     {
         SQLOperation* operation = nullptr;
@@ -53,9 +66,86 @@ void DatabaseWorker::WorkerThread()
         if (_cancelationToken || !operation)
             return;
 
+        if (_batchSize == 1 || !operation->IsBatchable())
+        {
+            Execute(operation);
+            continue;
+        }
+
+        // Drain the one-way operations that are already queued so they share one commit
+        batch.push_back(operation);
+        SQLOperation* next = nullptr;
+        while (batch.size() < _batchSize && _queue->Pop(next))
+        {
+            if (!next->IsBatchable())
+                break;
+
+            batch.push_back(next);
+            next = nullptr;
+        }
+
+        ExecuteBatch(batch);
+        batch.clear();
+
+        // Operation with a result that ended the batch, keep queue order
+        if (next)
+            Execute(next);
+    }
+}
+
+void DatabaseWorker::Execute(SQLOperation* operation)
+{
+    RecordQueueLatency(operation);
+    operation->SetConnection(_connection);
+    operation->call();
+
+    delete operation;
+}
+
+void DatabaseWorker::ExecuteBatch(std::vector<SQLOperation*>& batch)
+{
+    if (batch.size() == 1)
+    {
+        Execute(batch.front());
+        return;
+    }
+
+    // every operation needs the connection, the fallback below may reach ones the batch never did
+    for (SQLOperation* operation : batch)
+    {
+        RecordQueueLatency(operation);
         operation->SetConnection(_connection);
-        operation->call();
+    }
 
-        delete operation;
+    // A reconnect or a failed COMMIT fails the whole batch, the server discards the open transaction
+    _connection->SetBatchOpen(true);
+
+    bool success = _connection->BeginTransaction();
+    for (SQLOperation* operation : batch)
+    {
+        if (!success)
+            break;
+
+        success = operation->ExecuteBatched();
     }
+
+    if (success)
+        success = _connection->CommitTransaction();
+
+    if (!success)
+        _connection->RollbackTransaction();
+
+    _connection->SetBatchOpen(false);
+
+    if (!success)
+    {
+        TC_LOG_DEBUG("sql.driver", "Batch of " SZFMTD " operations failed, executing them separately.", batch.size());
+
+        // Keep the previous semantics: a failing operation must not discard the others
+        for (SQLOperation* operation : batch)
+            operation->call();
+    }
+
+    for (SQLOperation* operation : batch)
+        delete operation;
 }
@@ -18,7 +18,9 @@
 #ifndef _WORKERTHREAD_H
 #define _WORKERTHREAD_H
 
+#include "Define.h"
 #include <thread>
+#include <vector>
 #include "ProducerConsumerQueue.h"
 
 class MySQLConnection;
@@ -27,14 +29,19 @@ class SQLOperation;
 class TC_DATABASE_API DatabaseWorker
 {
     public:
-        DatabaseWorker(ProducerConsumerQueue<SQLOperation*>* newQueue, MySQLConnection* connection);
+        DatabaseWorker(ProducerConsumerQueue<SQLOperation*>* newQueue, MySQLConnection* connection, uint32 batchSize = 1);
         ~DatabaseWorker();
 
     private:
         ProducerConsumerQueue<SQLOperation*>* _queue;
         MySQLConnection* _connection;
+        uint32 _batchSize;
 
         void WorkerThread();
+        void Execute(SQLOperation* operation);
+        //! Commits a run of one-way operations in a single transaction,
+        //! replaying them one by one if any of them, the commit or the connection fails.
+        void ExecuteBatch(std::vector<SQLOperation*>& batch);
         std::thread _workerThread;
 
         std::atomic_bool _cancelationToken;
@@ -18,6 +18,9 @@
 #include "DatabaseWorkerPool.h"
 #include "DatabaseEnv.h"
 
+#include <algorithm>
+#include <cmath>
+
 #define MIN_MYSQL_SERVER_VERSION 50100u
 #define MIN_MYSQL_CLIENT_VERSION 50100u
 
@@ -34,9 +37,10 @@ DatabaseWorkerPool<T>::DatabaseWorkerPool()
 
 template <class T>
 void DatabaseWorkerPool<T>::SetConnectionInfo(std::string const& infoString,
-    uint8 const asyncThreads, uint8 const synchThreads)
+    uint8 const asyncThreads, uint8 const synchThreads, uint32 const batchSize /*= 1*/)
 {
     _connectionInfo = Trinity::make_unique<MySQLConnectionInfo>(infoString);
+    _connectionInfo->batchSize = batchSize;
 
     _async_threads = asyncThreads;
     _synch_threads = synchThreads;
@@ -260,6 +264,91 @@ void DatabaseWorkerPool<T>::KeepAlive()
         Enqueue(new PingOperation);
 }
 
+template <class T>
+void DatabaseWorkerPool<T>::LogStatementLatency(uint32 limit)
+{
+    if (!sLog->ShouldLog("sql.stats", LOG_LEVEL_INFO))
+        return;
+
+    struct StatementTotals
+    {
+        uint32 Index;
+        uint64 Count;
+        uint64 TotalMicros;
+        uint64 MaxMicros;
+        std::array<uint64, PreparedStatementLatency::BucketCount> Buckets;
+    };
+
+    std::vector<StatementTotals> totals;
+    for (auto& connections : _connections)
+    {
+        for (auto& connection : connections)
+        {
+            if (totals.empty())
+                totals.resize(connection->m_latency.size());
+
+            for (uint32 i = 0; i < totals.size(); ++i)
+            {
+                StatementTotals& total = totals[i];
+                total.Index = i;
+
+                PreparedStatementLatency const* latency = connection->GetStatementLatency(i);
+                if (!latency)
+                    continue;
+
+                total.Count += latency->Count.load(std::memory_order_relaxed);
+                total.TotalMicros += latency->TotalMicros.load(std::memory_order_relaxed);
+                total.MaxMicros = std::max(total.MaxMicros, latency->MaxMicros.load(std::memory_order_relaxed));
+                for (uint8 b = 0; b < PreparedStatementLatency::BucketCount; ++b)
+                    total.Buckets[b] += latency->Buckets[b].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    totals.erase(std::remove_if(totals.begin(), totals.end(), [](StatementTotals const& total) { return !total.Count; }), totals.end());
+    std::sort(totals.begin(), totals.end(), [](StatementTotals const& left, StatementTotals const& right)
+    {
+        return left.TotalMicros > right.TotalMicros;
+    });
+
+    if (totals.size() > limit)
+        totals.resize(limit);
+
+    // Upper bound of the bucket holding the given fraction of executions
+    auto percentile = [](StatementTotals const& total, double fraction) -> uint64
+    {
+        uint64 const threshold = uint64(std::ceil(double(total.Count) * fraction));
+        uint64 seen = 0;
+        for (uint8 b = 0; b < PreparedStatementLatency::BucketCount; ++b)
+        {
+            seen += total.Buckets[b];
+            if (seen >= threshold)
+                return b + 1 < PreparedStatementLatency::BucketCount ? (uint64(1) << b) : total.MaxMicros;
+        }
+
+        return total.MaxMicros;
+    };
+
+    // Every connection registers the query strings, prepared on it or not
+    PreparedStatementMap const* queries = _connections[IDX_SYNCH].empty() ? nullptr : &_connections[IDX_SYNCH].front()->m_queries;
+
+    TC_LOG_INFO("sql.stats", "DatabasePool '%s': top " SZFMTD " prepared statements by execution time.", GetDatabaseName(), totals.size());
+    for (StatementTotals const& total : totals)
+    {
+        std::string query;
+        if (queries)
+        {
+            auto itr = queries->find(total.Index);
+            if (itr != queries->end())
+                query = itr->second.first.substr(0, 60);
+        }
+
+        TC_LOG_INFO("sql.stats", "  stmt %u: " UI64FMTD " calls, total " UI64FMTD " ms, avg " UI64FMTD " us, p50 < " UI64FMTD " us, p99 < " UI64FMTD " us, max " UI64FMTD " us - %s",
+            total.Index, total.Count, total.TotalMicros / 1000, total.TotalMicros / total.Count,
+            percentile(total, 0.5), percentile(total, 0.99), total.MaxMicros, query.c_str());
+    }
+}
+
 template <class T>
 uint32 DatabaseWorkerPool<T>::OpenConnections(InternalIndex type, uint8 numConnections)
 {
@@ -64,7 +64,7 @@ class DatabaseWorkerPool
             _queue->Cancel();
         }
 
-        void SetConnectionInfo(std::string const& infoString, uint8 const asyncThreads, uint8 const synchThreads);
+        void SetConnectionInfo(std::string const& infoString, uint8 const asyncThreads, uint8 const synchThreads, uint32 const batchSize = 1);
 
         uint32 Open();
 
@@ -271,6 +271,10 @@ class DatabaseWorkerPool
         //! Keeps all our MySQL connections alive, prevent the server from disconnecting us.
         void KeepAlive();
 
+        //! Logs the prepared statements with the highest accumulated execution time
+        //! over all connections to the "sql.stats" logger.
+        void LogStatementLatency(uint32 limit);
+
     private:
         uint32 OpenConnections(InternalIndex type, uint8 numConnections);
 
@@ -150,7 +150,11 @@ void CharacterDatabaseConnection::DoPrepareStatements()
     PrepareStatement(CHAR_DEL_EMPTY_EXPIRED_MAIL, "DELETE FROM mail WHERE expire_time < ? AND has_items = 0 AND body = ''", CONNECTION_ASYNC);
     PrepareStatement(CHAR_SEL_EXPIRED_MAIL, "SELECT id, messageType, sender, receiver, has_items, expire_time, cod, checked, mailTemplateId FROM mail WHERE expire_time < ?", CONNECTION_SYNCH);
     PrepareStatement(CHAR_SEL_EXPIRED_MAIL_ITEMS, "SELECT item_guid, itemEntry, mail_id FROM mail_items mi INNER JOIN item_instance ii ON ii.guid = mi.item_guid LEFT JOIN mail mm ON mi.mail_id = mm.id WHERE mm.id IS NOT NULL AND mm.expire_time < ?", CONNECTION_SYNCH);
-    PrepareStatement(CHAR_UPD_MAIL_RETURNED, "UPDATE mail SET sender = ?, receiver = ?, expire_time = ?, deliver_time = ?, cod = 0, checked = ? WHERE id = ?", CONNECTION_ASYNC);
+    PrepareStatement(CHAR_UPD_MAIL_RETURNED, "UPDATE mail SET sender = ?, receiver = ?, expire_time = ?, deliver_time = ?, cod = 0, checked = ? WHERE id = ? AND expire_time < ?", CONNECTION_ASYNC);
+    PrepareStatement(CHAR_UPD_RETURNED_MAIL_ITEM_RECEIVER, "UPDATE mail_items mi INNER JOIN mail m ON m.id = mi.mail_id SET mi.receiver = ? WHERE mi.item_guid = ? AND m.id = ? AND m.receiver = ?", CONNECTION_ASYNC);
+    PrepareStatement(CHAR_UPD_RETURNED_MAIL_ITEM_OWNER, "UPDATE item_instance ii INNER JOIN mail_items mi ON mi.item_guid = ii.guid INNER JOIN mail m ON m.id = mi.mail_id SET ii.owner_guid = ? WHERE ii.guid = ? AND m.id = ? AND m.receiver = ?", CONNECTION_ASYNC);
+    PrepareStatement(CHAR_DEL_EXPIRED_MAIL_ITEM_INSTANCE, "DELETE ii FROM item_instance ii INNER JOIN mail_items mi ON mi.item_guid = ii.guid INNER JOIN mail m ON m.id = mi.mail_id WHERE ii.guid = ? AND m.id = ? AND m.expire_time < ?", CONNECTION_ASYNC);
+    PrepareStatement(CHAR_DEL_EXPIRED_MAIL_BY_ID, "DELETE FROM mail WHERE id = ? AND expire_time < ?", CONNECTION_ASYNC);
     PrepareStatement(CHAR_UPD_MAIL_ITEM_RECEIVER, "UPDATE mail_items SET receiver = ? WHERE item_guid = ?", CONNECTION_ASYNC);
     PrepareStatement(CHAR_UPD_ITEM_OWNER, "UPDATE item_instance SET owner_guid = ? WHERE guid = ?", CONNECTION_ASYNC);
 
@@ -132,6 +132,10 @@ enum CharacterDatabaseStatements
     CHAR_SEL_EXPIRED_MAIL,
     CHAR_SEL_EXPIRED_MAIL_ITEMS,
     CHAR_UPD_MAIL_RETURNED,
+    CHAR_UPD_RETURNED_MAIL_ITEM_RECEIVER,
+    CHAR_UPD_RETURNED_MAIL_ITEM_OWNER,
+    CHAR_DEL_EXPIRED_MAIL_ITEM_INSTANCE,
+    CHAR_DEL_EXPIRED_MAIL_BY_ID,
     CHAR_UPD_MAIL_ITEM_RECEIVER,
     CHAR_UPD_ITEM_OWNER,
     CHAR_SEL_ITEM_REFUNDS,
@@ -38,6 +38,7 @@
 MySQLConnection::MySQLConnection(MySQLConnectionInfo& connInfo) :
 m_reconnecting(false),
 m_prepareError(false),
+m_batchOpen(false),
 m_queue(NULL),
 m_Mysql(NULL),
 m_connectionInfo(connInfo),
@@ -46,12 +47,13 @@ m_connectionFlags(CONNECTION_SYNCH) { }
 MySQLConnection::MySQLConnection(ProducerConsumerQueue<SQLOperation*>* queue, MySQLConnectionInfo& connInfo) :
 m_reconnecting(false),
 m_prepareError(false),
+m_batchOpen(false),
 m_queue(queue),
 m_Mysql(NULL),
 m_connectionInfo(connInfo),
 m_connectionFlags(CONNECTION_ASYNC)
 {
-    m_worker = Trinity::make_unique<DatabaseWorker>(m_queue, this);
+    m_worker = Trinity::make_unique<DatabaseWorker>(m_queue, this, connInfo.batchSize);
 }
 
 MySQLConnection::~MySQLConnection()
@@ -151,9 +153,27 @@ uint32 MySQLConnection::Open()
 bool MySQLConnection::PrepareStatements()
 {
     DoPrepareStatements();
+
+    // Keep collected statistics across reconnects
+    if (m_latency.empty())
+        m_latency = std::vector<PreparedStatementLatency>(m_stmts.size());
+
     return !m_prepareError;
 }
 
+void PreparedStatementLatency::Add(uint64 micros)
+{
+    uint8 bucket = 0;
+    while (bucket < BucketCount - 1 && (uint64(1) << bucket) <= micros)
+        ++bucket;
+
+    Count.fetch_add(1, std::memory_order_relaxed);
+    TotalMicros.fetch_add(micros, std::memory_order_relaxed);
+    Buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    if (micros > MaxMicros.load(std::memory_order_relaxed))
+        MaxMicros.store(micros, std::memory_order_relaxed);
+}
+
 bool MySQLConnection::Execute(const char* sql)
 {
     if (!m_Mysql)
@@ -169,7 +189,7 @@ bool MySQLConnection::Execute(const char* sql)
             TC_LOG_INFO("sql.sql", "SQL: %s", sql);
             TC_LOG_ERROR("sql.sql", "[%u] %s", lErrno, mysql_error(m_Mysql));
 
-            if (_HandleMySQLErrno(lErrno))  // If it returns true, an error was handled successfully (i.e. reconnection)
+            if (_HandleMySQLErrno(lErrno) && !m_batchOpen)  // If it returns true, an error was handled successfully (i.e. reconnection)
                 return Execute(sql);       // Try again
 
             return false;
@@ -199,13 +219,14 @@ bool MySQLConnection::Execute(PreparedStatement* stmt)
         MYSQL_BIND* msql_BIND = m_mStmt->GetBind();
 
         uint32 _s = getMSTime();
+        auto const start = std::chrono::steady_clock::now();
 
         if (mysql_stmt_bind_param(msql_STMT, msql_BIND))
         {
             uint32 lErrno = mysql_errno(m_Mysql);
             TC_LOG_ERROR("sql.sql", "SQL(p): %s\n [ERROR]: [%u] %s", m_mStmt->getQueryString(m_queries[index].first).c_str(), lErrno, mysql_stmt_error(msql_STMT));
 
-            if (_HandleMySQLErrno(lErrno))  // If it returns true, an error was handled successfully (i.e. reconnection)
+            if (_HandleMySQLErrno(lErrno) && !m_batchOpen)  // If it returns true, an error was handled successfully (i.e. reconnection)
                 return Execute(stmt);       // Try again
 
             m_mStmt->ClearParameters();
@@ -217,13 +238,16 @@ bool MySQLConnection::Execute(PreparedStatement* stmt)
             uint32 lErrno = mysql_errno(m_Mysql);
             TC_LOG_ERROR("sql.sql", "SQL(p): %s\n [ERROR]: [%u] %s", m_mStmt->getQueryString(m_queries[index].first).c_str(), lErrno, mysql_stmt_error(msql_STMT));
 
-            if (_HandleMySQLErrno(lErrno))  // If it returns true, an error was handled successfully (i.e. reconnection)
+            if (_HandleMySQLErrno(lErrno) && !m_batchOpen)  // If it returns true, an error was handled successfully (i.e. reconnection)
                 return Execute(stmt);       // Try again
 
             m_mStmt->ClearParameters();
             return false;
         }
 
+        if (index < m_latency.size())
+            m_latency[index].Add(uint64(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count()));
+
         TC_LOG_DEBUG("sql.sql", "[%u ms] SQL(p): %s", getMSTimeDiff(_s, getMSTime()), m_mStmt->getQueryString(m_queries[index].first).c_str());
 
         m_mStmt->ClearParameters();
@@ -249,6 +273,7 @@ bool MySQLConnection::_Query(PreparedStatement* stmt, MYSQL_RES **pResult, uint6
         MYSQL_BIND* msql_BIND = m_mStmt->GetBind();
 
         uint32 _s = getMSTime();
+        auto const start = std::chrono::steady_clock::now();
 
         if (mysql_stmt_bind_param(msql_STMT, msql_BIND))
         {
@@ -275,6 +300,9 @@ bool MySQLConnection::_Query(PreparedStatement* stmt, MYSQL_RES **pResult, uint6
             return false;
         }
 
+        if (index < m_latency.size())
+            m_latency[index].Add(uint64(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count()));
+
         TC_LOG_DEBUG("sql.sql", "[%u ms] SQL(p): %s", getMSTimeDiff(_s, getMSTime()), m_mStmt->getQueryString(m_queries[index].first).c_str());
 
         m_mStmt->ClearParameters();
@@ -345,9 +373,9 @@ bool MySQLConnection::_Query(const char *sql, MYSQL_RES **pResult, MYSQL_FIELD *
     return true;
 }
 
-void MySQLConnection::BeginTransaction()
+bool MySQLConnection::BeginTransaction()
 {
-    Execute("START TRANSACTION");
+    return Execute("START TRANSACTION");
 }
 
 void MySQLConnection::RollbackTransaction()
@@ -355,9 +383,9 @@ void MySQLConnection::RollbackTransaction()
     Execute("ROLLBACK");
 }
 
-void MySQLConnection::CommitTransaction()
+bool MySQLConnection::CommitTransaction()
 {
-    Execute("COMMIT");
+    return Execute("COMMIT");
 }
 
 int MySQLConnection::ExecuteTransaction(SQLTransaction& transaction)
@@ -368,23 +396,35 @@ int MySQLConnection::ExecuteTransaction(SQLTransaction& transaction)
 
     BeginTransaction();
 
-    std::list<SQLElementData>::const_iterator itr;
-    for (itr = queries.begin(); itr != queries.end(); ++itr)
+    if (!ExecuteTransactionQueries(queries))
     {
-        SQLElementData const& data = *itr;
-        switch (itr->type)
+        TC_LOG_WARN("sql.sql", "Transaction aborted. %u queries not executed.", (uint32)queries.size());
+        int errorCode = GetLastError();
+        RollbackTransaction();
+        return errorCode;
+    }
+
+    // we might encounter errors during certain queries, and depending on the kind of error
+    // we might want to restart the transaction. So to prevent data loss, we only clean up when it's all done.
+    // This is done in calling functions DatabaseWorkerPool<T>::DirectCommitTransaction and TransactionTask::Execute,
+    // and not while iterating over every element.
+
+    CommitTransaction();
+    return 0;
+}
+
+bool MySQLConnection::ExecuteTransactionQueries(std::list<SQLElementData> const& queries)
+{
+    for (SQLElementData const& data : queries)
+    {
+        switch (data.type)
         {
             case SQL_ELEMENT_PREPARED:
             {
                 PreparedStatement* stmt = data.element.stmt;
                 ASSERT(stmt);
                 if (!Execute(stmt))
-                {
-                    TC_LOG_WARN("sql.sql", "Transaction aborted. %u queries not executed.", (uint32)queries.size());
-                    int errorCode = GetLastError();
-                    RollbackTransaction();
-                    return errorCode;
-                }
+                    return false;
             }
             break;
             case SQL_ELEMENT_RAW:
@@ -392,24 +432,13 @@ int MySQLConnection::ExecuteTransaction(SQLTransaction& transaction)
                 const char* sql = data.element.query;
                 ASSERT(sql);
                 if (!Execute(sql))
-                {
-                    TC_LOG_WARN("sql.sql", "Transaction aborted. %u queries not executed.", (uint32)queries.size());
-                    int errorCode = GetLastError();
-                    RollbackTransaction();
-                    return errorCode;
-                }
+                    return false;
             }
             break;
         }
     }
 
-    // we might encounter errors during certain queries, and depending on the kind of error
-    // we might want to restart the transaction. So to prevent data loss, we only clean up when it's all done.
-    // This is done in calling functions DatabaseWorkerPool<T>::DirectCommitTransaction and TransactionTask::Execute,
-    // and not while iterating over every element.
-
-    CommitTransaction();
-    return 0;
+    return true;
 }
 
 MySQLPreparedStatement* MySQLConnection::GetPreparedStatement(uint32 index)
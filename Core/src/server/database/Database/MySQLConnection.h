@@ -20,6 +20,9 @@
 #include "Util.h"
 #include "ProducerConsumerQueue.h"
 
+#include <atomic>
+#include <array>
+
 #ifndef _MYSQLCONNECTION_H
 #define _MYSQLCONNECTION_H
 
@@ -37,7 +40,7 @@ enum ConnectionFlags
 
 struct TC_DATABASE_API MySQLConnectionInfo
 {
-    explicit MySQLConnectionInfo(std::string const& infoString)
+    explicit MySQLConnectionInfo(std::string const& infoString) : batchSize(1)
     {
         Tokenizer tokens(infoString, ';');
 
@@ -58,6 +61,21 @@ struct TC_DATABASE_API MySQLConnectionInfo
     std::string database;
     std::string host;
     std::string port_or_socket;
+    uint32 batchSize;   //! Max queued one-way operations an async worker commits in one transaction
+};
+
+//! Execution time histogram of a single prepared statement, written by the connection owner only.
+struct PreparedStatementLatency
+{
+    //! Bucket i holds executions that took less than 2^i microseconds, the last one everything above.
+    static uint8 const BucketCount = 20;
+
+    void Add(uint64 micros);
+
+    std::atomic<uint64> Count;
+    std::atomic<uint64> TotalMicros;
+    std::atomic<uint64> MaxMicros;
+    std::array<std::atomic<uint64>, BucketCount> Buckets;
 };
 
 typedef std::map<uint32 /*index*/, std::pair<std::string /*query*/, ConnectionFlags /*sync/async*/> > PreparedStatementMap;
@@ -85,16 +103,22 @@ class TC_DATABASE_API MySQLConnection
         bool _Query(const char *sql, MYSQL_RES **pResult, MYSQL_FIELD **pFields, uint64* pRowCount, uint32* pFieldCount);
         bool _Query(PreparedStatement* stmt, MYSQL_RES **pResult, uint64* pRowCount, uint32* pFieldCount);
 
-        void BeginTransaction();
+        bool BeginTransaction();
         void RollbackTransaction();
-        void CommitTransaction();
+        bool CommitTransaction();
         int ExecuteTransaction(SQLTransaction& transaction);
+        //! Executes the queries of a transaction without opening or committing it.
+        bool ExecuteTransactionQueries(std::list<SQLElementData> const& queries);
 
         operator bool () const { return m_Mysql != NULL; }
         void Ping() { mysql_ping(m_Mysql); }
 
         uint32 GetLastError() { return mysql_errno(m_Mysql); }
 
+        //! While a batch is open a statement that lost the connection fails instead of being retried
+        //! on the new one, the server already rolled back the statements executed before it.
+        void SetBatchOpen(bool open) { m_batchOpen = open; }
+
     protected:
         bool LockIfReady()
         {
@@ -115,11 +139,18 @@ class TC_DATABASE_API MySQLConnection
 
         virtual void DoPrepareStatements() = 0;
 
+        PreparedStatementLatency const* GetStatementLatency(uint32 index) const
+        {
+            return index < m_latency.size() ? &m_latency[index] : nullptr;
+        }
+
     protected:
         std::vector<std::unique_ptr<MySQLPreparedStatement>> m_stmts; //! PreparedStatements storage
+        std::vector<PreparedStatementLatency> m_latency;              //! Execution time per statement index
         PreparedStatementMap                 m_queries;       //! Query storage
         bool                                 m_reconnecting;  //! Are we reconnecting?
         bool                                 m_prepareError;  //! Was there any error while preparing statements?
+        bool                                 m_batchOpen;     //! Is a worker batch transaction open?
 
     private:
         bool _HandleMySQLErrno(uint32 errNo, uint8 attempts = 5);
@@ -67,6 +67,8 @@ class TC_DATABASE_API PreparedResultSet
         ~PreparedResultSet();
 
         bool NextRow();
+        /// Back to the first row, all rows are buffered so they can be walked again
+        void Reset() { m_rowPosition = 0; }
         uint64 GetRowCount() const { return m_rowCount; }
         uint32 GetFieldCount() const { return m_fieldCount; }
 
@@ -19,6 +19,7 @@
 #define _SQLOPERATION_H
 
 #include "QueryResult.h"
+#include <chrono>
 
 //- Forward declare (don't include header to prevent circular includes)
 class PreparedStatement;
@@ -56,7 +57,7 @@ class MySQLConnection;
 class TC_DATABASE_API SQLOperation
 {
     public:
-        SQLOperation(): m_conn(NULL) { }
+        SQLOperation(): m_conn(NULL), m_queueTime(std::chrono::steady_clock::now()) { }
         virtual ~SQLOperation() { }
 
         virtual int call()
@@ -67,7 +68,13 @@ class TC_DATABASE_API SQLOperation
         virtual bool Execute() = 0;
         virtual void SetConnection(MySQLConnection* con) { m_conn = con; }
 
+        //! One-way operations (no resultset) may share a single transaction with other queued operations.
+        virtual bool IsBatchable() const { return false; }
+        //! Executes the operation inside a transaction already opened by the worker, must not begin or commit one itself.
+        virtual bool ExecuteBatched() { return Execute(); }
+
         MySQLConnection* m_conn;
+        std::chrono::steady_clock::time_point m_queueTime;      // operations are created right before being queued
 
     private:
         SQLOperation(SQLOperation const& right) = delete;
@@ -85,3 +85,10 @@ bool TransactionTask::Execute()
 
     return false;
 }
+
+bool TransactionTask::ExecuteBatched()
+{
+    // The enclosing batch transaction is rolled back and replayed operation by operation on failure,
+    // so no deadlock handling or cleanup is needed here
+    return m_conn->ExecuteTransactionQueries(m_trans->m_queries);
+}
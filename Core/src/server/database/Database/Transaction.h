@@ -67,8 +67,11 @@ class TC_DATABASE_API TransactionTask : public SQLOperation
         TransactionTask(SQLTransaction trans) : m_trans(trans) { }
         ~TransactionTask() { }
 
+        bool IsBatchable() const override { return true; }
+
     protected:
         bool Execute() override;
+        bool ExecuteBatched() override;
 
         SQLTransaction m_trans;
         static std::mutex _deadlockLock;
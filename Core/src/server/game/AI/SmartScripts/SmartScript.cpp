@@ -36,6 +36,7 @@
 #include "SpellMgr.h"
 #include "Vehicle.h"
 #include "GameEventMgr.h"
+#include "World.h"
 
 SmartScript::SmartScript()
 {
@@ -52,6 +53,8 @@ SmartScript::SmartScript()
     mTemplate = SMARTAI_TEMPLATE_BASIC;
     mScriptType = SMART_SCRIPT_TYPE_CREATURE;
     isProcessingTimedActionList = false;
+    mEventIndexOffsets.fill(0);
+    mEventConditionsGeneration = 0;
 }
 
 SmartScript::~SmartScript()
@@ -82,18 +85,65 @@ void SmartScript::OnReset()
 
 void SmartScript::ProcessEventsFor(SMART_EVENT e, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellInfo* spell, GameObject* gob)
 {
-    for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
+    if (e == SMART_EVENT_LINK || uint32(e) >= SMART_EVENT_END)//special handling
+        return;
+
+    if (mEventConditionsGeneration != sConditionMgr->GetLoadGeneration())
+        ResolveEventConditions();
+
+    // bucket bounds are copied, actions may install new events (and rebuild the index) while we iterate
+    uint32 const begin = mEventIndexOffsets[e];
+    uint32 const end = mEventIndexOffsets[e + 1];
+    for (uint32 i = begin; i < end && i < mEventIndex.size(); ++i)
     {
-        SMART_EVENT eventType = SMART_EVENT(i->GetEventType());
-        if (eventType == SMART_EVENT_LINK)//special handling
+        uint32 pos = mEventIndex[i];
+        if (pos >= mEvents.size())
             continue;
 
-        if (eventType == e /*&& (!i->event.event_phase_mask || IsInPhase(i->event.event_phase_mask)) && !(i->event.event_flags & SMART_EVENT_FLAG_NOT_REPEATABLE && i->runOnce)*/)
-            if (sConditionMgr->IsObjectMeetingSmartEventConditions(i->entryOrGuid, i->event_id, i->source_type, unit, GetBaseObject()))
-                ProcessEvent(*i, unit, var0, var1, bvar, spell, gob);
+        SmartScriptHolder& holder = mEvents[pos];
+        if (holder.GetEventType() != uint32(e))
+            continue;
+
+        if (ConditionContainer const* conditions = pos < mEventConditions.size() ? mEventConditions[pos] : nullptr)
+        {
+            ConditionSourceInfo sourceInfo(unit, GetBaseObject());
+            if (!sConditionMgr->IsObjectMeetToConditions(sourceInfo, *conditions))
+                continue;
+        }
+
+        ProcessEvent(holder, unit, var0, var1, bvar, spell, gob);
     }
 }
 
+void SmartScript::BuildEventIndex()
+{
+    // counting sort by event type, keeps the original order of mEvents inside each bucket
+    mEventIndexOffsets.fill(0);
+    for (SmartScriptHolder const& holder : mEvents)
+        if (holder.GetEventType() < SMART_EVENT_END)
+            ++mEventIndexOffsets[holder.GetEventType() + 1];
+
+    for (uint32 type = 1; type <= SMART_EVENT_END; ++type)
+        mEventIndexOffsets[type] += mEventIndexOffsets[type - 1];
+
+    std::array<uint32, SMART_EVENT_END + 1> next = mEventIndexOffsets;
+    mEventIndex.assign(mEventIndexOffsets[SMART_EVENT_END], 0);
+    for (uint32 pos = 0; pos < mEvents.size(); ++pos)
+        if (mEvents[pos].GetEventType() < SMART_EVENT_END)
+            mEventIndex[next[mEvents[pos].GetEventType()]++] = pos;
+
+    ResolveEventConditions();
+}
+
+void SmartScript::ResolveEventConditions()
+{
+    mEventConditions.resize(mEvents.size());
+    for (uint32 pos = 0; pos < mEvents.size(); ++pos)
+        mEventConditions[pos] = sConditionMgr->GetConditionsForSmartEvent(mEvents[pos].entryOrGuid, mEvents[pos].event_id, mEvents[pos].source_type);
+
+    mEventConditionsGeneration = sConditionMgr->GetLoadGeneration();
+}
+
 void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellInfo* spell, GameObject* gob)
 {
     //calc random
@@ -2825,6 +2875,27 @@ ObjectList* SmartScript::GetWorldObjectsInDist(float dist)
     return targets;
 }
 
+class SmartEventProfiler
+{
+    public:
+        explicit SmartEventProfiler(SmartScriptHolder const& e) : _event(e), _enabled(sWorld->getBoolConfig(CONFIG_SMARTAI_PROFILING))
+        {
+            if (_enabled)
+                _start = std::chrono::steady_clock::now();
+        }
+
+        ~SmartEventProfiler()
+        {
+            if (_enabled)
+                sSmartScriptMgr->AddProfileSample(_event, uint64(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _start).count()));
+        }
+
+    private:
+        SmartScriptHolder const& _event;
+        bool _enabled;
+        std::chrono::steady_clock::time_point _start;
+};
+
 void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellInfo* spell, GameObject* gob)
 {
     if (!e.active && e.GetEventType() != SMART_EVENT_LINK)
@@ -2833,6 +2904,9 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
     if ((e.event.event_phase_mask && !IsInPhase(e.event.event_phase_mask)) || ((e.event.event_flags & SMART_EVENT_FLAG_NOT_REPEATABLE) && e.runOnce))
         return;
 
+    // time includes linked events processed from the actions of this one
+    SmartEventProfiler profiler(e);
+
     switch (e.GetEventType())
     {
         case SMART_EVENT_LINK://special handling
@@ -3473,6 +3547,7 @@ void SmartScript::InstallEvents()
             mEvents.push_back(*i);//must be before UpdateTimers
 
         mInstallEvents.clear();
+        BuildEventIndex();
     }
 }
 
@@ -3588,6 +3663,8 @@ void SmartScript::GetScript()
         e = sSmartScriptMgr->GetScript((int32)trigger->ID, mScriptType);
         FillScript(e, NULL, trigger);
     }
+
+    BuildEventIndex();
 }
 
 void SmartScript::OnInitialize(WorldObject* obj, AreaTriggerEntry const* at)
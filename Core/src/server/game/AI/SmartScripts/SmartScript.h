@@ -24,8 +24,10 @@
 #include "Unit.h"
 #include "Spell.h"
 #include "GridNotifiers.h"
+#include "ConditionMgr.h"
 
 #include "SmartScriptMgr.h"
+#include <array>
 //#include "SmartAI.h"
 
 class TC_GAME_API SmartScript
@@ -281,6 +283,15 @@ class TC_GAME_API SmartScript
         SMARTAI_TEMPLATE mTemplate;
         void InstallEvents();
 
+        // mEvents positions grouped by event type, bucket for type t is [mEventIndexOffsets[t], mEventIndexOffsets[t + 1])
+        std::vector<uint32> mEventIndex;
+        std::array<uint32, SMART_EVENT_END + 1> mEventIndexOffsets;
+        // conditions of mEvents[i], resolved again when ConditionMgr is reloaded
+        std::vector<ConditionContainer const*> mEventConditions;
+        uint32 mEventConditionsGeneration;
+        void BuildEventIndex();
+        void ResolveEventConditions();
+
         void RemoveStoredEvent(uint32 id)
         {
             if (!mStoredEvents.empty())
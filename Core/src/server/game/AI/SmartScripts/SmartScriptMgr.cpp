@@ -1392,3 +1392,45 @@ CacheSpellContainerBounds SmartAIMgr::GetCreateItemSpellContainerBounds(uint32 i
     return CreateItemSpellStore.equal_range(itemId);
 }
 
+
+void SmartAIMgr::AddProfileSample(SmartScriptHolder const& e, uint64 micros)
+{
+    ProfileKey key;
+    key.EntryOrGuid = e.entryOrGuid;
+    key.SourceType = uint32(e.GetScriptType());
+    key.EventId = e.event_id;
+
+    std::lock_guard<std::mutex> lock(_profileLock);
+    ProfileEntry& entry = _profile[key];
+    entry.EventType = e.GetEventType();
+    ++entry.Count;
+    entry.TotalMicros += micros;
+    if (micros > entry.MaxMicros)
+        entry.MaxMicros = micros;
+}
+
+void SmartAIMgr::LogProfile(uint32 limit)
+{
+    std::vector<std::pair<ProfileKey, ProfileEntry>> entries;
+    {
+        std::lock_guard<std::mutex> lock(_profileLock);
+        entries.assign(_profile.begin(), _profile.end());
+    }
+
+    if (entries.empty())
+        return;
+
+    std::sort(entries.begin(), entries.end(), [](std::pair<ProfileKey, ProfileEntry> const& left, std::pair<ProfileKey, ProfileEntry> const& right)
+    {
+        return left.second.TotalMicros > right.second.TotalMicros;
+    });
+
+    if (entries.size() > limit)
+        entries.resize(limit);
+
+    TC_LOG_INFO("scripts.ai", "SmartAIMgr::LogProfile: top %u SmartAI events by total processing time", uint32(entries.size()));
+    for (std::pair<ProfileKey, ProfileEntry> const& itr : entries)
+        TC_LOG_INFO("scripts.ai", "  Entry " SI64FMTD " SourceType %u Event %u (type %u): " UI64FMTD " calls, " UI64FMTD " us total, " UI64FMTD " us avg, " UI64FMTD " us max",
+            itr.first.EntryOrGuid, itr.first.SourceType, itr.first.EventId, itr.second.EventType,
+            itr.second.Count, itr.second.TotalMicros, itr.second.TotalMicros / itr.second.Count, itr.second.MaxMicros);
+}
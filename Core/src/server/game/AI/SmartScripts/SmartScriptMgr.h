@@ -24,6 +24,7 @@
 #include "Unit.h"
 #include "Spell.h"
 #include "DB2Stores.h"
+#include <mutex>
 
 //#include "SmartScript.h"
 //#include "SmartAI.h"
@@ -1540,10 +1541,37 @@ class TC_GAME_API SmartAIMgr
             return SmartScriptHolderDummy;
         }
 
+        // SmartAI.Profiling, time spent per entryOrGuid/source type/event id
+        void AddProfileSample(SmartScriptHolder const& e, uint64 micros);
+        void LogProfile(uint32 limit);
+
     private:
         //event stores
         SmartAIEventMap mEventMap[SMART_SCRIPT_TYPE_MAX];
 
+        struct ProfileKey
+        {
+            int64 EntryOrGuid;
+            uint32 SourceType;
+            uint32 EventId;
+
+            bool operator<(ProfileKey const& right) const
+            {
+                return std::tie(EntryOrGuid, SourceType, EventId) < std::tie(right.EntryOrGuid, right.SourceType, right.EventId);
+            }
+        };
+
+        struct ProfileEntry
+        {
+            uint32 EventType = 0;
+            uint64 Count = 0;
+            uint64 TotalMicros = 0;
+            uint64 MaxMicros = 0;
+        };
+
+        std::map<ProfileKey, ProfileEntry> _profile;
+        std::mutex _profileLock;
+
         bool IsEventValid(SmartScriptHolder& e);
         bool IsTargetValid(SmartScriptHolder const& e);
 
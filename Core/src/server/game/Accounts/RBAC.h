@@ -730,6 +730,9 @@ enum RBACPermissions
     RBAC_PERM_COMMAND_DEBUG_BOUNDARY                         = 836,
 
     // custom permissions 1000+
+    RBAC_PERM_COMMAND_SERVER_PROFILE                         = 1000,
+    RBAC_PERM_COMMAND_SERVER_PROFILE_OPCODES                 = 1001,
+    RBAC_PERM_COMMAND_SERVER_PROFILE_TICKS                   = 1002,
     RBAC_PERM_MAX
 };
 
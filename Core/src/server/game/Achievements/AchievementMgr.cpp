@@ -605,6 +605,11 @@ CriteriaList const& PlayerAchievementMgr::GetCriteriaByType(CriteriaTypes type)
     return sCriteriaMgr->GetPlayerCriteriaByType(type);
 }
 
+CriteriaList const& PlayerAchievementMgr::GetCriteriaByAsset(CriteriaTypes type, uint32 asset) const
+{
+    return sCriteriaMgr->GetPlayerCriteriaByAsset(type, asset);
+}
+
 GuildAchievementMgr::GuildAchievementMgr(Guild* owner) : _owner(owner)
 {
 }
@@ -924,6 +929,11 @@ CriteriaList const& GuildAchievementMgr::GetCriteriaByType(CriteriaTypes type) c
     return sCriteriaMgr->GetGuildCriteriaByType(type);
 }
 
+CriteriaList const& GuildAchievementMgr::GetCriteriaByAsset(CriteriaTypes type, uint32 asset) const
+{
+    return sCriteriaMgr->GetGuildCriteriaByAsset(type, asset);
+}
+
 std::string PlayerAchievementMgr::GetOwnerInfo() const
 {
     return Trinity::StringFormat("%s %s", _owner->GetGUID().ToString().c_str(), _owner->GetName().c_str());
@@ -101,6 +101,7 @@ protected:
 
     std::string GetOwnerInfo() const override;
     CriteriaList const& GetCriteriaByType(CriteriaTypes type) const override;
+    CriteriaList const& GetCriteriaByAsset(CriteriaTypes type, uint32 asset) const override;
 
 private:
     Player* _owner;
@@ -133,6 +134,7 @@ protected:
 
     std::string GetOwnerInfo() const override;
     CriteriaList const& GetCriteriaByType(CriteriaTypes type) const override;
+    CriteriaList const& GetCriteriaByAsset(CriteriaTypes type, uint32 asset) const override;
 
 private:
     Guild* _owner;
@@ -427,7 +427,11 @@ void CriteriaHandler::UpdateCriteria(CriteriaTypes type, uint64 miscValue1 /*= 0
     TC_LOG_DEBUG("criteria", "CriteriaHandler::UpdateCriteria(%s, %u, " UI64FMTD ", " UI64FMTD ", " UI64FMTD ") %s",
         CriteriaMgr::GetCriteriaTypeString(type), type, miscValue1, miscValue2, miscValue3, GetOwnerInfo().c_str());
 
-    CriteriaList const& criteriaList = GetCriteriaByType(type);
+    // A non-zero miscValue1 is the asset for these types, criteria for other assets can never pass RequirementsSatisfied
+    CriteriaList const& criteriaList = miscValue1 && CriteriaMgr::IsAssetIndexedCriteriaType(type)
+        ? GetCriteriaByAsset(type, uint32(miscValue1)) : GetCriteriaByType(type);
+
+    uint32 matched = 0;
     for (Criteria const* criteria : criteriaList)
     {
         CriteriaTreeList const* trees = sCriteriaMgr->GetCriteriaTreesByCriteria(criteria->ID);
@@ -439,6 +443,8 @@ void CriteriaHandler::UpdateCriteria(CriteriaTypes type, uint64 miscValue1 /*= 0
             if (!data->Meets(referencePlayer, unit, uint32(miscValue1)))
                 continue;
 
+        ++matched;
+
         switch (type)
         {
             // std. case: increment at 1
@@ -739,6 +745,8 @@ void CriteriaHandler::UpdateCriteria(CriteriaTypes type, uint64 miscValue1 /*= 0
             AfterCriteriaTreeUpdate(tree, referencePlayer);
         }
     }
+
+    sCriteriaMgr->AddUpdateStatistics(type, uint32(criteriaList.size()), matched);
 }
 
 void CriteriaHandler::UpdateTimedCriteria(uint32 timeDiff)
@@ -1984,6 +1992,25 @@ CriteriaMgr* CriteriaMgr::Instance()
     return &instance;
 }
 
+void CriteriaMgr::LogUpdateStatistics() const
+{
+    if (!sLog->ShouldLog("criteria", LOG_LEVEL_INFO))
+        return;
+
+    TC_LOG_INFO("criteria", "CriteriaMgr::LogUpdateStatistics: criteria checked and matched by UpdateCriteria per type");
+    for (uint32 type = 0; type < CRITERIA_TYPE_TOTAL; ++type)
+    {
+        uint64 checks = _updateChecks[type].load(std::memory_order_relaxed);
+        if (!checks)
+            continue;
+
+        uint64 matches = _updateMatches[type].load(std::memory_order_relaxed);
+        TC_LOG_INFO("criteria", "  %s (%u): " UI64FMTD " checked, " UI64FMTD " matched (%.2f%%)%s",
+            GetCriteriaTypeString(type), type, checks, matches, double(matches) * 100.0 / double(checks),
+            IsAssetIndexedCriteriaType(CriteriaTypes(type)) ? ", indexed by asset" : "");
+    }
+}
+
 //==========================================================
 CriteriaMgr::~CriteriaMgr()
 {
@@ -2157,18 +2184,24 @@ void CriteriaMgr::LoadCriteriaList()
         {
             ++criterias;
             _criteriasByType[criteriaEntry->Type].push_back(criteria);
+            if (IsAssetIndexedCriteriaType(CriteriaTypes(criteriaEntry->Type)))
+                _criteriasByAsset[criteriaEntry->Type][criteriaEntry->Asset.ID].push_back(criteria);
         }
 
         if (criteria->FlagsCu & CRITERIA_FLAG_CU_GUILD)
         {
             ++guildCriterias;
             _guildCriteriasByType[criteriaEntry->Type].push_back(criteria);
+            if (IsAssetIndexedCriteriaType(CriteriaTypes(criteriaEntry->Type)))
+                _guildCriteriasByAsset[criteriaEntry->Type][criteriaEntry->Asset.ID].push_back(criteria);
         }
 
         if (criteria->FlagsCu & CRITERIA_FLAG_CU_SCENARIO)
         {
             ++scenarioCriterias;
             _scenarioCriteriasByType[criteriaEntry->Type].push_back(criteria);
+            if (IsAssetIndexedCriteriaType(CriteriaTypes(criteriaEntry->Type)))
+                _scenarioCriteriasByAsset[criteriaEntry->Type][criteriaEntry->Asset.ID].push_back(criteria);
         }
 
         if (criteriaEntry->StartTimer)
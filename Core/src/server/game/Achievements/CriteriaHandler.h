@@ -22,6 +22,8 @@
 #include "ObjectGuid.h"
 #include "Transaction.h"
 #include "Common.h"
+#include <array>
+#include <atomic>
 
 class Player;
 class Unit;
@@ -290,6 +292,7 @@ protected:
 
     virtual std::string GetOwnerInfo() const = 0;
     virtual CriteriaList const& GetCriteriaByType(CriteriaTypes type) const = 0;
+    virtual CriteriaList const& GetCriteriaByAsset(CriteriaTypes type, uint32 asset) const = 0;
 
     CriteriaProgressMap _criteriaProgress;
     std::map<uint32, uint32 /*ms time left*/> _timeCriteriaTrees;
@@ -321,6 +324,21 @@ public:
         return _scenarioCriteriasByType[type];
     }
 
+    CriteriaList const& GetPlayerCriteriaByAsset(CriteriaTypes type, uint32 asset) const
+    {
+        return GetCriteriaByAsset(_criteriasByAsset[type], asset);
+    }
+
+    CriteriaList const& GetGuildCriteriaByAsset(CriteriaTypes type, uint32 asset) const
+    {
+        return GetCriteriaByAsset(_guildCriteriasByAsset[type], asset);
+    }
+
+    CriteriaList const& GetScenarioCriteriaByAsset(CriteriaTypes type, uint32 asset) const
+    {
+        return GetCriteriaByAsset(_scenarioCriteriasByAsset[type], asset);
+    }
+
     CriteriaTreeList const* GetCriteriaTreesByCriteria(uint32 criteriaId) const
     {
         auto itr = _criteriaTreeByCriteria.find(criteriaId);
@@ -356,6 +374,55 @@ public:
         return false;
     }
 
+    // Types for which RequirementsSatisfied rejects every criteria whose Asset differs from a non-zero miscValue1
+    static bool IsAssetIndexedCriteriaType(CriteriaTypes type)
+    {
+        switch (type)
+        {
+            case CRITERIA_TYPE_KILL_CREATURE:
+            case CRITERIA_TYPE_REACH_SKILL_LEVEL:
+            case CRITERIA_TYPE_COMPLETE_QUESTS_IN_ZONE:
+            case CRITERIA_TYPE_KILLED_BY_CREATURE:
+            case CRITERIA_TYPE_COMPLETE_QUEST:
+            case CRITERIA_TYPE_BE_SPELL_TARGET:
+            case CRITERIA_TYPE_CAST_SPELL:
+            case CRITERIA_TYPE_WIN_ARENA:
+            case CRITERIA_TYPE_LEARN_SPELL:
+            case CRITERIA_TYPE_OWN_ITEM:
+            case CRITERIA_TYPE_LEARN_SKILL_LEVEL:
+            case CRITERIA_TYPE_USE_ITEM:
+            case CRITERIA_TYPE_LOOT_ITEM:
+            case CRITERIA_TYPE_GAIN_REPUTATION:
+            case CRITERIA_TYPE_EQUIP_ITEM:
+            case CRITERIA_TYPE_HK_CLASS:
+            case CRITERIA_TYPE_HK_RACE:
+            case CRITERIA_TYPE_DO_EMOTE:
+            case CRITERIA_TYPE_USE_GAMEOBJECT:
+            case CRITERIA_TYPE_BE_SPELL_TARGET2:
+            case CRITERIA_TYPE_FISH_IN_GAMEOBJECT:
+            case CRITERIA_TYPE_LEARN_SKILLLINE_SPELLS:
+            case CRITERIA_TYPE_HONORABLE_KILL_AT_AREA:
+            case CRITERIA_TYPE_CAST_SPELL2:
+            case CRITERIA_TYPE_LEARN_SKILL_LINE:
+            case CRITERIA_TYPE_BG_OBJECTIVE_CAPTURE:
+            case CRITERIA_TYPE_CURRENCY:
+            case CRITERIA_TYPE_PLACE_GARRISON_BUILDING:
+                return true;
+            default:
+                break;
+        }
+
+        return false;
+    }
+
+    void AddUpdateStatistics(CriteriaTypes type, uint32 checked, uint32 matched)
+    {
+        _updateChecks[type].fetch_add(checked, std::memory_order_relaxed);
+        _updateMatches[type].fetch_add(matched, std::memory_order_relaxed);
+    }
+
+    void LogUpdateStatistics() const;
+
     template<typename Func>
     static void WalkCriteriaTree(CriteriaTree const* tree, Func const& func)
     {
@@ -372,6 +439,15 @@ public:
     Criteria const* GetCriteria(uint32 criteriaId) const;
 
 private:
+    typedef std::unordered_map<uint32 /*asset*/, CriteriaList> CriteriaAssetMap;
+
+    static CriteriaList const& GetCriteriaByAsset(CriteriaAssetMap const& criteriaByAsset, uint32 asset)
+    {
+        static CriteriaList const emptyList;
+        auto itr = criteriaByAsset.find(asset);
+        return itr != criteriaByAsset.end() ? itr->second : emptyList;
+    }
+
     CriteriaDataMap _criteriaDataMap;
 
     std::unordered_map<uint32, CriteriaTree*> _criteriaTrees;
@@ -385,7 +461,16 @@ private:
     CriteriaList _guildCriteriasByType[CRITERIA_TYPE_TOTAL];
     CriteriaList _scenarioCriteriasByType[CRITERIA_TYPE_TOTAL];
 
+    // same lists keyed by Asset for IsAssetIndexedCriteriaType types
+    CriteriaAssetMap _criteriasByAsset[CRITERIA_TYPE_TOTAL];
+    CriteriaAssetMap _guildCriteriasByAsset[CRITERIA_TYPE_TOTAL];
+    CriteriaAssetMap _scenarioCriteriasByAsset[CRITERIA_TYPE_TOTAL];
+
     CriteriaList _criteriasByTimedType[CRITERIA_TIMED_TYPE_MAX];
+
+    // criteria evaluated by UpdateCriteria and how many of them passed all requirements
+    std::array<std::atomic<uint64>, CRITERIA_TYPE_TOTAL> _updateChecks = { };
+    std::array<std::atomic<uint64>, CRITERIA_TYPE_TOTAL> _updateMatches = { };
 };
 
 #define sCriteriaMgr CriteriaMgr::Instance()
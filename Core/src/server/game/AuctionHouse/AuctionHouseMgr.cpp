@@ -558,12 +558,14 @@ void AuctionHouseObject::AddAuction(AuctionEntry* auction)
     ASSERT(auction);
 
     AuctionsMap[auction->Id] = auction;
+    AddToSearchIndex(auction);
     sScriptMgr->OnAuctionAdd(this, auction);
 }
 
 bool AuctionHouseObject::RemoveAuction(AuctionEntry* auction)
 {
     bool wasInMap = AuctionsMap.erase(auction->Id) ? true : false;
+    RemoveFromSearchIndex(auction);
 
     sScriptMgr->OnAuctionRemove(this, auction);
 
@@ -629,6 +631,246 @@ void AuctionHouseObject::Update()
 
     // Run DB changes
     CharacterDatabase.CommitTransaction(trans);
+
+    // Drop search results that can no longer be paged
+    for (auto itr = _searchResults.begin(); itr != _searchResults.end();)
+    {
+        if (itr->second.Generation != _generation)
+            itr = _searchResults.erase(itr);
+        else
+            ++itr;
+    }
+}
+
+void AuctionHouseObject::AddToSearchIndex(AuctionEntry const* auction)
+{
+    ++_generation;
+
+    ItemTemplate const* proto = sObjectMgr->GetItemTemplate(auction->itemEntry);
+    if (!proto)
+        return;
+
+    _auctionsByClass[std::make_pair(proto->GetClass(), proto->GetSubClass())].insert(auction->Id);
+    if (proto->GetQuality() < MAX_ITEM_QUALITY)
+        _auctionsByQuality[proto->GetQuality()].insert(auction->Id);
+    _auctionsByLevel[proto->GetBaseRequiredLevel()].insert(auction->Id);
+
+    AddSearchNames(auction);
+}
+
+void AuctionHouseObject::AddSearchNames(AuctionEntry const* auction)
+{
+    Item* item = sAuctionMgr->GetAItem(auction->itemGUIDLow);
+    if (!item)
+        return;
+
+    // sessions only use available dbc locales, falling back to the default one
+    for (uint8 locale = 0; locale < TOTAL_LOCALES; ++locale)
+    {
+        if (sWorld->GetAvailableDbcLocale(LocaleConstant(locale)) != locale)
+            continue;
+
+        std::wstring wname;
+        if (BuildSearchName(item, LocaleConstant(locale), wname))
+            _searchNames[locale][auction->Id] = std::move(wname);
+    }
+}
+
+void AuctionHouseObject::RemoveFromSearchIndex(AuctionEntry const* auction)
+{
+    ++_generation;
+
+    for (uint8 locale = 0; locale < TOTAL_LOCALES; ++locale)
+        _searchNames[locale].erase(auction->Id);
+
+    ItemTemplate const* proto = sObjectMgr->GetItemTemplate(auction->itemEntry);
+    if (!proto)
+        return;
+
+    auto classItr = _auctionsByClass.find(std::make_pair(proto->GetClass(), proto->GetSubClass()));
+    if (classItr != _auctionsByClass.end())
+    {
+        classItr->second.erase(auction->Id);
+        if (classItr->second.empty())
+            _auctionsByClass.erase(classItr);
+    }
+
+    if (proto->GetQuality() < MAX_ITEM_QUALITY)
+        _auctionsByQuality[proto->GetQuality()].erase(auction->Id);
+
+    auto levelItr = _auctionsByLevel.find(proto->GetBaseRequiredLevel());
+    if (levelItr != _auctionsByLevel.end())
+    {
+        levelItr->second.erase(auction->Id);
+        if (levelItr->second.empty())
+            _auctionsByLevel.erase(levelItr);
+    }
+}
+
+void AuctionHouseObject::CollectSearchCandidates(AuctionSearchFilter const& filter, std::vector<uint32>& candidates, bool& allAuctions) const
+{
+    // Pick the smallest index matching the filter, MatchesSearch still checks every condition
+    std::vector<AuctionIdSet const*> best;
+    size_t bestSize = AuctionsMap.size();
+    allAuctions = true;
+
+    auto consider = [&](std::vector<AuctionIdSet const*>& sets)
+    {
+        size_t size = 0;
+        for (AuctionIdSet const* set : sets)
+            size += set->size();
+
+        if (size <= bestSize)
+        {
+            best.swap(sets);
+            bestSize = size;
+            allAuctions = false;
+        }
+    };
+
+    if (filter.ItemClass != 0xffffffff)
+    {
+        std::vector<AuctionIdSet const*> sets;
+        if (filter.ItemSubClass != 0xffffffff)
+        {
+            auto itr = _auctionsByClass.find(std::make_pair(filter.ItemClass, filter.ItemSubClass));
+            if (itr != _auctionsByClass.end())
+                sets.push_back(&itr->second);
+        }
+        else
+        {
+            for (auto itr = _auctionsByClass.lower_bound(std::make_pair(filter.ItemClass, 0u)); itr != _auctionsByClass.end() && itr->first.first == filter.ItemClass; ++itr)
+                sets.push_back(&itr->second);
+        }
+
+        consider(sets);
+    }
+
+    if (filter.Quality != 0xffffffff)
+    {
+        std::vector<AuctionIdSet const*> sets;
+        if (filter.Quality < MAX_ITEM_QUALITY)
+            sets.push_back(&_auctionsByQuality[filter.Quality]);
+
+        consider(sets);
+    }
+
+    if (filter.LevelMin != 0)
+    {
+        std::vector<AuctionIdSet const*> sets;
+        if (filter.LevelMax == 0 || filter.LevelMax >= filter.LevelMin)
+        {
+            auto end = filter.LevelMax != 0 ? _auctionsByLevel.upper_bound(filter.LevelMax) : _auctionsByLevel.end();
+            for (auto itr = _auctionsByLevel.lower_bound(filter.LevelMin); itr != end; ++itr)
+                sets.push_back(&itr->second);
+        }
+
+        consider(sets);
+    }
+
+    if (allAuctions)
+        return;
+
+    candidates.reserve(bestSize);
+    for (AuctionIdSet const* set : best)
+        candidates.insert(candidates.end(), set->begin(), set->end());
+
+    // keep the listing in auction id order, same as iterating AuctionsMap
+    if (best.size() > 1)
+        std::sort(candidates.begin(), candidates.end());
+}
+
+bool AuctionHouseObject::BuildSearchName(Item* item, LocaleConstant locale, std::wstring& wname)
+{
+    std::string name = item->GetTemplate()->GetName(locale);
+    if (name.empty())
+        return false;
+
+    // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
+    //  that matches the search but it may not equal item->GetItemRandomPropertyId()
+    //  used in BuildAuctionInfo() which then causes wrong items to be listed
+    int32 propRefID = item->GetItemRandomPropertyId();
+
+    if (propRefID)
+    {
+        // Append the suffix to the name (ie: of the Monkey) if one exists
+        // These are found in ItemRandomSuffix.dbc and ItemRandomProperties.dbc
+        //  even though the DBC names seem misleading
+
+        const char* suffix = nullptr;
+
+        if (propRefID < 0)
+        {
+            const ItemRandomSuffixEntry* itemRandSuffix = sItemRandomSuffixStore.LookupEntry(-propRefID);
+            if (itemRandSuffix)
+                suffix = itemRandSuffix->Name->Str[locale];
+        }
+        else
+        {
+            const ItemRandomPropertiesEntry* itemRandProp = sItemRandomPropertiesStore.LookupEntry(propRefID);
+            if (itemRandProp)
+                suffix = itemRandProp->Name->Str[locale];
+        }
+
+        // dbc local name
+        if (suffix)
+        {
+            // Append the suffix (ie: of the Monkey) to the name using localization
+            // or default enUS if localization is invalid
+            name += ' ';
+            name += suffix;
+        }
+    }
+
+    if (!Utf8toWStr(name, wname))
+        return false;
+
+    // converting to lower case, the searched name is lower case too
+    wstrToLower(wname);
+    return true;
+}
+
+bool AuctionHouseObject::MatchesSearch(AuctionEntry const* auction, AuctionSearchFilter const& filter, Player* player, time_t curTime) const
+{
+    // Skip expired auctions
+    if (auction->expire_time < curTime)
+        return false;
+
+    Item* item = sAuctionMgr->GetAItem(auction->itemGUIDLow);
+    if (!item)
+        return false;
+
+    ItemTemplate const* proto = item->GetTemplate();
+
+    if (filter.ItemClass != 0xffffffff && proto->GetClass() != filter.ItemClass)
+        return false;
+
+    if (filter.ItemSubClass != 0xffffffff && proto->GetSubClass() != filter.ItemSubClass)
+        return false;
+
+    if (filter.InventoryType != 0xffffffff && proto->GetInventoryType() != InventoryType(filter.InventoryType))
+        return false;
+
+    if (filter.Quality != 0xffffffff && proto->GetQuality() != filter.Quality)
+        return false;
+
+    if (filter.LevelMin != 0 && (proto->GetBaseRequiredLevel() < filter.LevelMin || (filter.LevelMax != 0 && proto->GetBaseRequiredLevel() > filter.LevelMax)))
+        return false;
+
+    if (filter.Usable != 0 && player->CanUseItem(item) != EQUIP_ERR_OK)
+        return false;
+
+    // Allow search by suffix (ie: of the Monkey) or partial name (ie: Monkey)
+    // No need to do any of this if no search term was entered
+    if (!filter.Name.empty())
+    {
+        std::unordered_map<uint32, std::wstring> const& names = _searchNames[player->GetSession()->GetSessionDbcLocale()];
+        auto name = names.find(auction->Id);
+        if (name == names.end() || name->second.find(filter.Name) == std::wstring::npos)
+            return false;
+    }
+
+    return true;
 }
 
 void AuctionHouseObject::BuildListBidderItems(WorldPackets::AuctionHouse::AuctionListBidderItemsResult& packet, Player* player, uint32& totalcount)
@@ -663,91 +905,57 @@ void AuctionHouseObject::BuildListAuctionItems(WorldPackets::AuctionHouse::Aucti
 {
     time_t curTime = sWorld->GetGameTime();
 
-    for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
+    AuctionSearchFilter filter;
+    filter.Name = wsearchedname;
+    filter.LevelMin = levelmin;
+    filter.LevelMax = levelmax;
+    filter.Usable = usable;
+    filter.InventoryType = inventoryType;
+    filter.ItemClass = itemClass;
+    filter.ItemSubClass = itemSubClass;
+    filter.Quality = quality;
+
+    // A new search (first page) is always evaluated again, next pages reuse the matches
+    // as long as no auction was added or removed in the meantime
+    AuctionSearchResult& result = _searchResults[player->GetGUID()];
+    if (!listfrom || result.Generation != _generation || !(result.Filter == filter))
     {
-        AuctionEntry* Aentry = itr->second;
-        // Skip expired auctions
-        if (Aentry->expire_time < curTime)
-            continue;
-
-        Item* item = sAuctionMgr->GetAItem(Aentry->itemGUIDLow);
-        if (!item)
-            continue;
+        result.Filter = filter;
+        result.Generation = _generation;
+        result.AuctionIds.clear();
 
-        ItemTemplate const* proto = item->GetTemplate();
+        std::vector<uint32> candidates;
+        bool allAuctions;
+        CollectSearchCandidates(filter, candidates, allAuctions);
 
-        if (itemClass != 0xffffffff && proto->GetClass() != itemClass)
-            continue;
-
-        if (itemSubClass != 0xffffffff && proto->GetSubClass() != itemSubClass)
-            continue;
-
-        if (inventoryType != 0xffffffff && proto->GetInventoryType() != InventoryType(inventoryType))
-            continue;
-
-        if (quality != 0xffffffff && proto->GetQuality() != quality)
-            continue;
+        if (allAuctions)
+        {
+            for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
+                if (MatchesSearch(itr->second, filter, player, curTime))
+                    result.AuctionIds.push_back(itr->first);
+        }
+        else
+        {
+            for (uint32 auctionId : candidates)
+                if (AuctionEntry* Aentry = GetAuction(auctionId))
+                    if (MatchesSearch(Aentry, filter, player, curTime))
+                        result.AuctionIds.push_back(auctionId);
+        }
+    }
 
-        if (levelmin != 0 && (proto->GetBaseRequiredLevel() < levelmin || (levelmax != 0 && proto->GetBaseRequiredLevel() > levelmax)))
+    totalcount += uint32(result.AuctionIds.size());
+    for (size_t i = listfrom; i < result.AuctionIds.size() && packet.Items.size() < 50; ++i)
+    {
+        AuctionEntry* Aentry = GetAuction(result.AuctionIds[i]);
+        if (!Aentry)
             continue;
 
-        if (usable != 0 && player->CanUseItem(item) != EQUIP_ERR_OK)
+        // cached matches may have expired since, Update() reaps them only once a minute
+        if (Aentry->expire_time < curTime)
             continue;
 
-        // Allow search by suffix (ie: of the Monkey) or partial name (ie: Monkey)
-        // No need to do any of this if no search term was entered
-        if (!wsearchedname.empty())
-        {
-            std::string name = proto->GetName(player->GetSession()->GetSessionDbcLocale());
-            if (name.empty())
-                continue;
-
-            // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
-            //  that matches the search but it may not equal item->GetItemRandomPropertyId()
-            //  used in BuildAuctionInfo() which then causes wrong items to be listed
-            int32 propRefID = item->GetItemRandomPropertyId();
-
-            if (propRefID)
-            {
-                // Append the suffix to the name (ie: of the Monkey) if one exists
-                // These are found in ItemRandomSuffix.dbc and ItemRandomProperties.dbc
-                //  even though the DBC names seem misleading
-
-                const char* suffix = nullptr;
-
-                if (propRefID < 0)
-                {
-                    const ItemRandomSuffixEntry* itemRandSuffix = sItemRandomSuffixStore.LookupEntry(-propRefID);
-                    if (itemRandSuffix)
-                        suffix = itemRandSuffix->Name->Str[player->GetSession()->GetSessionDbcLocale()];
-                }
-                else
-                {
-                    const ItemRandomPropertiesEntry* itemRandProp = sItemRandomPropertiesStore.LookupEntry(propRefID);
-                    if (itemRandProp)
-                        suffix = itemRandProp->Name->Str[player->GetSession()->GetSessionDbcLocale()];
-                }
-
-                // dbc local name
-                if (suffix)
-                {
-                    // Append the suffix (ie: of the Monkey) to the name using localization
-                    // or default enUS if localization is invalid
-                    name += ' ';
-                    name += suffix;
-                }
-            }
-
-            // Perform the search (with or without suffix)
-            if (!Utf8FitTo(name, wsearchedname))
-                continue;
-        }
-
-        // Add the item if no search term or if entered search term was found
-        if (packet.Items.size() < 50 && totalcount >= listfrom)
+        if (Item* item = sAuctionMgr->GetAItem(Aentry->itemGUIDLow))
             Aentry->BuildAuctionInfo(packet.Items, true, item);
-
-        ++totalcount;
     }
 }
 
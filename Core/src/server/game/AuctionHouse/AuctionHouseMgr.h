@@ -23,6 +23,7 @@
 #include "DatabaseEnv.h"
 #include "DBCStructure.h"
 #include "ObjectGuid.h"
+#include "SharedDefines.h"
 #include "AuctionHousePackets.h"
 #include <set>
 
@@ -146,8 +147,54 @@ class TC_GAME_API AuctionHouseObject
         uint32 global, uint32 cursor, uint32 tombstone, uint32 count);
 
   private:
+    typedef std::set<uint32> AuctionIdSet;
+
+    struct AuctionSearchFilter
+    {
+        std::wstring Name;
+        uint8 LevelMin;
+        uint8 LevelMax;
+        uint8 Usable;
+        uint32 InventoryType;
+        uint32 ItemClass;
+        uint32 ItemSubClass;
+        uint32 Quality;
+
+        bool operator==(AuctionSearchFilter const& right) const
+        {
+            return Name == right.Name && LevelMin == right.LevelMin && LevelMax == right.LevelMax && Usable == right.Usable &&
+                InventoryType == right.InventoryType && ItemClass == right.ItemClass && ItemSubClass == right.ItemSubClass && Quality == right.Quality;
+        }
+    };
+
+    // Matching auction ids of the last search of a player, reused when the client asks for the next pages
+    struct AuctionSearchResult
+    {
+        AuctionSearchFilter Filter;
+        uint32 Generation;
+        std::vector<uint32> AuctionIds;
+    };
+
+    void AddToSearchIndex(AuctionEntry const* auction);
+    void RemoveFromSearchIndex(AuctionEntry const* auction);
+    void CollectSearchCandidates(AuctionSearchFilter const& filter, std::vector<uint32>& candidates, bool& allAuctions) const;
+    bool MatchesSearch(AuctionEntry const* auction, AuctionSearchFilter const& filter, Player* player, time_t curTime) const;
+    void AddSearchNames(AuctionEntry const* auction);
+    static bool BuildSearchName(Item* item, LocaleConstant locale, std::wstring& wname);
+
     AuctionEntryMap AuctionsMap;
 
+    // Secondary indexes of AuctionsMap by item template fields, maintained by AddAuction/RemoveAuction
+    std::map<std::pair<uint32, uint32>, AuctionIdSet> _auctionsByClass;   // (class, subclass)
+    AuctionIdSet _auctionsByQuality[MAX_ITEM_QUALITY];
+    std::map<int32, AuctionIdSet> _auctionsByLevel;                        // base required level
+    // lower case item name with random suffix per available locale, filled by AddAuction
+    std::unordered_map<uint32, std::wstring> _searchNames[TOTAL_LOCALES];
+
+    // incremented whenever an auction is added or removed, invalidates _searchResults
+    uint32 _generation = 0;
+    std::unordered_map<ObjectGuid, AuctionSearchResult> _searchResults;
+
     // Map of throttled players for GetAll, and throttle expiry time
     // Stored here, rather than player object to maintain persistence after logout
     PlayerGetAllThrottleMap GetAllThrottleMap;
@@ -259,6 +259,26 @@ void ThreatContainer::clearReferences()
     }
 
     iThreatList.clear();
+    iReferencesByTarget.clear();
+}
+
+//============================================================
+
+void ThreatContainer::remove(HostileReference* hostileRef)
+{
+    auto itr = iReferencesByTarget.find(hostileRef->getUnitGuid());
+    if (itr == iReferencesByTarget.end() || *itr->second != hostileRef)
+        return;
+
+    iThreatList.erase(itr->second);
+    iReferencesByTarget.erase(itr);
+}
+
+//============================================================
+
+void ThreatContainer::addReference(HostileReference* hostileRef)
+{
+    iReferencesByTarget[hostileRef->getUnitGuid()] = iThreatList.insert(iThreatList.end(), hostileRef);
 }
 
 //============================================================
@@ -268,15 +288,11 @@ HostileReference* ThreatContainer::getReferenceByTarget(Unit* victim) const
     if (!victim)
         return NULL;
 
-    ObjectGuid guid = victim->GetGUID();
-    for (ThreatContainer::StorageType::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
-    {
-        HostileReference* ref = (*i);
-        if (ref && ref->getUnitGuid() == guid)
-            return ref;
-    }
+    auto itr = iReferencesByTarget.find(victim->GetGUID());
+    if (itr == iReferencesByTarget.end())
+        return NULL;
 
-    return NULL;
+    return *itr->second;
 }
 
 //============================================================
@@ -304,7 +320,32 @@ void ThreatContainer::modifyThreatPercent(Unit* victim, int32 percent)
 void ThreatContainer::update()
 {
     if (iDirty && iThreatList.size() > 1)
-        iThreatList.sort(Trinity::ThreatOrderPred());
+    {
+        // usually only a few references changed their threat since the last update,
+        // move those into place instead of sorting the whole list again
+        Trinity::ThreatOrderPred pred;
+        uint32 moved = 0;
+        for (StorageType::iterator itr = std::next(iThreatList.begin()); itr != iThreatList.end();)
+        {
+            StorageType::iterator next = std::next(itr);
+            StorageType::iterator pos = itr;
+            while (pos != iThreatList.begin() && pred(*itr, *std::prev(pos)))
+                --pos;
+
+            if (pos != itr)
+            {
+                if (++moved > MAX_THREAT_LIST_MOVES)
+                {
+                    iThreatList.sort(pred);
+                    break;
+                }
+
+                iThreatList.splice(pos, iThreatList, itr);
+            }
+
+            itr = next;
+        }
+    }
 
     iDirty = false;
 }
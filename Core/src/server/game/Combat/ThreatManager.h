@@ -26,6 +26,7 @@
 #include "ObjectGuid.h"
 
 #include <list>
+#include <unordered_map>
 
 //==============================================================
 
@@ -35,6 +36,7 @@ class ThreatManager;
 class SpellInfo;
 
 #define THREAT_UPDATE_INTERVAL 1 * IN_MILLISECONDS    // Server should send threat update to client periodically each second
+#define MAX_THREAT_LIST_MOVES 8                         // out of order references moved in place before falling back to a full sort
 
 //==============================================================
 // Class to calculate the real threat based
@@ -177,15 +179,9 @@ class TC_GAME_API ThreatContainer
         StorageType const & getThreatList() const { return iThreatList; }
 
     private:
-        void remove(HostileReference* hostileRef)
-        {
-            iThreatList.remove(hostileRef);
-        }
+        void remove(HostileReference* hostileRef);
 
-        void addReference(HostileReference* hostileRef)
-        {
-            iThreatList.push_back(hostileRef);
-        }
+        void addReference(HostileReference* hostileRef);
 
         void clearReferences();
 
@@ -193,6 +189,7 @@ class TC_GAME_API ThreatContainer
         void update();
 
         StorageType iThreatList;
+        std::unordered_map<ObjectGuid, StorageType::iterator> iReferencesByTarget;  // list iterators stay valid through sort and splice
         bool iDirty;
 };
 
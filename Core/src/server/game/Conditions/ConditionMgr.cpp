@@ -691,7 +691,7 @@ std::string Condition::ToString(bool ext /*= false*/) const
     return ss.str();
 }
 
-ConditionMgr::ConditionMgr() { }
+ConditionMgr::ConditionMgr() : _loadGeneration(0) { }
 
 ConditionMgr::~ConditionMgr()
 {
@@ -927,6 +927,18 @@ bool ConditionMgr::IsObjectMeetingSmartEventConditions(int64 entryOrGuid, uint32
     return true;
 }
 
+ConditionContainer const* ConditionMgr::GetConditionsForSmartEvent(int64 entryOrGuid, uint32 eventId, uint32 sourceType) const
+{
+    SmartEventConditionContainer::const_iterator itr = SmartEventConditionStore.find(std::make_pair(entryOrGuid, sourceType));
+    if (itr != SmartEventConditionStore.end())
+    {
+        ConditionsByEntryMap::const_iterator i = itr->second.find(eventId + 1);
+        if (i != itr->second.end())
+            return &i->second;
+    }
+    return nullptr;
+}
+
 bool ConditionMgr::IsObjectMeetingVendorItemConditions(uint32 creatureId, uint32 itemId, Player* player, Creature* vendor) const
 {
     ConditionEntriesByCreatureIdMap::const_iterator itr = NpcVendorConditionContainerStore.find(creatureId);
@@ -954,6 +966,7 @@ void ConditionMgr::LoadConditions(bool isReload)
     uint32 oldMSTime = getMSTime();
 
     Clean();
+    ++_loadGeneration;
 
     //must clear all custom handled cases (groupped types) before reload
     if (isReload)
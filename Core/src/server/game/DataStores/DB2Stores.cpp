@@ -145,6 +145,7 @@ TaxiPathNodesByPath                             sTaxiPathNodesByPath;
 typedef std::list<std::string> DB2StoreProblemList;
 
 uint32 DB2FilesCount = 0;
+std::size_t DB2MemoryUsage = 0;
 
 template<class T>
 inline void LoadDB2(uint32& availableDb2Locales, DB2StoreProblemList& errlist, DB2Manager::StorageMap& stores, DB2Storage<T>* storage, std::string const& db2Path, uint32 defaultLocale)
@@ -154,6 +155,7 @@ inline void LoadDB2(uint32& availableDb2Locales, DB2StoreProblemList& errlist, D
         "Size of '%s' set by format string (%u) not equal size of C++ structure (" SZFMTD ").",
         storage->GetFileName().c_str(), DB2FileLoader::GetFormatRecordSize(storage->GetFormat()), sizeof(T));
 
+    uint32 oldMSTime = getMSTime();
     ++DB2FilesCount;
 
     if (storage->Load(db2Path + localeNames[defaultLocale] + '/', defaultLocale))
@@ -171,6 +173,10 @@ inline void LoadDB2(uint32& availableDb2Locales, DB2StoreProblemList& errlist, D
 
             storage->LoadStringsFromDB(i);
         }
+
+        DB2MemoryUsage += storage->GetMemoryUsage();
+        TC_LOG_DEBUG("server.loading", "Loaded %s: %u rows, " SZFMTD " KB in %u ms", storage->GetFileName().c_str(), storage->GetNumRows(),
+            storage->GetMemoryUsage() / 1024, GetMSTimeDiffToNow(oldMSTime));
     }
     else
     {
@@ -551,7 +557,7 @@ void DB2Manager::LoadStores(std::string const& dataPath, uint32 defaultLocale)
         exit(1);
     }
 
-    TC_LOG_INFO("server.loading", ">> Initialized %d DB2 data stores in %u ms", DB2FilesCount, GetMSTimeDiffToNow(oldMSTime));
+    TC_LOG_INFO("server.loading", ">> Initialized %d DB2 data stores (" SZFMTD " KB) in %u ms", DB2FilesCount, DB2MemoryUsage / 1024, GetMSTimeDiffToNow(oldMSTime));
 }
 
 DB2StorageBase const* DB2Manager::GetStorage(uint32 type) const
@@ -183,6 +183,7 @@ GameTable<GtSpellScalingEntry>              sGtSpellScalingStore(GtSpellScalingf
 typedef std::list<std::string> StoreProblemList;
 
 uint32 DBCFileCount = 0;
+std::size_t DBCMemoryUsage = 0;
 uint32 GameTableCount = 0;
 
 template<class T>
@@ -193,6 +194,7 @@ inline void LoadDBC(uint32& availableDbcLocales, StoreProblemList& errors, DBCSt
         "Size of '%s' set by format string (%u) not equal size of C++ structure (%u).",
         filename.c_str(), DBCFileLoader::GetFormatRecordSize(storage.GetFormat()), uint32(sizeof(T)));
 
+    uint32 oldMSTime = getMSTime();
     ++DBCFileCount;
     std::string dbcFilename = dbcPath + localeNames[defaultLocale] + '/' + filename;
     SqlDbc * sql = NULL;
@@ -214,6 +216,10 @@ inline void LoadDBC(uint32& availableDbcLocales, StoreProblemList& errors, DBCSt
             if (!storage.LoadStringsFrom(localizedName.c_str()))
                 availableDbcLocales &= ~(1<<i);             // mark as not available for speedup next checks
         }
+
+        DBCMemoryUsage += storage.GetMemoryUsage();
+        TC_LOG_DEBUG("server.loading", "Loaded %s: %u rows, " SZFMTD " KB in %u ms", filename.c_str(), storage.GetNumRows(),
+            storage.GetMemoryUsage() / 1024, GetMSTimeDiffToNow(oldMSTime));
     }
     else
     {
@@ -508,7 +514,7 @@ void LoadDBCStores(const std::string& dataPath, uint32 defaultLocale)
         exit(1);
     }
 
-    TC_LOG_INFO("server.loading", ">> Initialized %d DBC data stores in %u ms", DBCFileCount, GetMSTimeDiffToNow(oldMSTime));
+    TC_LOG_INFO("server.loading", ">> Initialized %d DBC data stores (" SZFMTD " KB) in %u ms", DBCFileCount, DBCMemoryUsage / 1024, GetMSTimeDiffToNow(oldMSTime));
 }
 
 void LoadGameTables(const std::string& dataPath, uint32 defaultLocale)
@@ -151,6 +151,7 @@ Player::Player(WorldSession* session) : Unit(true)
 
     m_zoneUpdateId = uint32(-1);
     m_zoneUpdateTimer = 0;
+    m_visibilityUpdateInstanceId = 0;
 
     m_areaUpdateId = 0;
     m_team = 0;
@@ -3962,19 +3963,13 @@ TrainerSpellState Player::GetTrainerSpellState(TrainerSpell const* trainer_spell
  * @param updateRealmChars when this flag is set, the amount of characters on that realm will be updated in the realmlist
  * @param deleteFinally    if this flag is set, the config option will be ignored and the character will be permanently removed from the database
  */
-void Player::DeleteFromDB(ObjectGuid playerguid, uint32 accountId, bool updateRealmChars, bool deleteFinally)
+static uint32 GetCharDeleteMethod(ObjectGuid playerguid, bool deleteFinally)
 {
-    // Avoid realm-update for non-existing account
-    if (accountId == 0)
-        updateRealmChars = false;
+    if (deleteFinally)
+        return CHAR_DELETE_REMOVE;
 
-    // Convert guid to low GUID for CharacterNameData, but also other methods on success
-    ObjectGuid::LowType guid = playerguid.GetCounter();
     uint32 charDeleteMethod = sWorld->getIntConfig(CONFIG_CHARDELETE_METHOD);
-
-    if (deleteFinally)
-        charDeleteMethod = CHAR_DELETE_REMOVE;
-    else if (CharacterInfo const* characterInfo = sWorld->GetCharacterInfo(playerguid)) // To avoid a query, we select loaded data. If it doesn't exist, return.
+    if (CharacterInfo const* characterInfo = sWorld->GetCharacterInfo(playerguid)) // To avoid a query, we select loaded data. If it doesn't exist, return.
     {
         // Define the required variables
         uint32 charDeleteMinLvl = sWorld->getIntConfig(characterInfo->Class != CLASS_DEATH_KNIGHT ? CONFIG_CHARDELETE_MIN_LEVEL : CONFIG_CHARDELETE_HEROIC_MIN_LEVEL);
@@ -3985,24 +3980,100 @@ void Player::DeleteFromDB(ObjectGuid playerguid, uint32 accountId, bool updateRe
             charDeleteMethod = CHAR_DELETE_REMOVE;
     }
 
-    if (ObjectGuid::LowType guildId = GetGuildIdFromDB(playerguid))
-        if (Guild* guild = sGuildMgr->GetGuildById(guildId))
+    return charDeleteMethod;
+}
+
+void Player::LoadDeleteQueries(ObjectGuid playerguid, bool removeCharacter, CharacterDeleteQueries& queries)
+{
+    ObjectGuid::LowType guid = playerguid.GetCounter();
+
+    queries.GuildId = GetGuildIdFromDB(playerguid);
+
+    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_PLAYER_ARENA_TEAMS);
+    stmt->setUInt64(0, guid);
+    queries.ArenaTeams = CharacterDatabase.Query(stmt);
+
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_GROUP_MEMBER);
+    stmt->setUInt64(0, guid);
+    queries.GroupMember = CharacterDatabase.Query(stmt);
+
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_PETITION_SIG_BY_GUID);
+    stmt->setUInt64(0, guid);
+    queries.PetitionSignatures = CharacterDatabase.Query(stmt);
+
+    if (!removeCharacter)
+        return;
+
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHAR_COD_ITEM_MAIL);
+    stmt->setUInt64(0, guid);
+    queries.ItemMails = CharacterDatabase.Query(stmt);
+
+    if (queries.ItemMails)
+    {
+        do
+        {
+            Field* mailFields = queries.ItemMails->Fetch();
+            if (mailFields[1].GetUInt8() != MAIL_NORMAL || !mailFields[7].GetBool())
+                continue;
+
+            uint32 mailId = mailFields[0].GetUInt32();
+            stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAILITEMS);
+            stmt->setUInt32(0, mailId);
+            queries.MailItems[mailId] = CharacterDatabase.Query(stmt);
+        }
+        while (queries.ItemMails->NextRow());
+
+        // DeleteFromDB walks the rows again
+        queries.ItemMails->Reset();
+    }
+
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHAR_PETS);
+    stmt->setUInt64(0, guid);
+    queries.Pets = CharacterDatabase.Query(stmt);
+
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHAR_SOCIAL);
+    stmt->setUInt64(0, guid);
+    queries.Friends = CharacterDatabase.Query(stmt);
+}
+
+void Player::DeleteFromDB(ObjectGuid playerguid, uint32 accountId, bool updateRealmChars, bool deleteFinally)
+{
+    CharacterDeleteQueries queries;
+    LoadDeleteQueries(playerguid, GetCharDeleteMethod(playerguid, deleteFinally) == CHAR_DELETE_REMOVE, queries);
+    DeleteFromDB(playerguid, accountId, updateRealmChars, deleteFinally, queries);
+}
+
+/**
+ * Deletes a character from the database without querying it, see LoadDeleteQueries
+ *
+ * @param queries          the rows read by LoadDeleteQueries, mail, pet and friend rows are needed if the character is removed
+ */
+void Player::DeleteFromDB(ObjectGuid playerguid, uint32 accountId, bool updateRealmChars, bool deleteFinally, CharacterDeleteQueries const& queries)
+{
+    // Avoid realm-update for non-existing account
+    if (accountId == 0)
+        updateRealmChars = false;
+
+    // Convert guid to low GUID for CharacterNameData, but also other methods on success
+    ObjectGuid::LowType guid = playerguid.GetCounter();
+    uint32 charDeleteMethod = GetCharDeleteMethod(playerguid, deleteFinally);
+
+    if (queries.GuildId)
+        if (Guild* guild = sGuildMgr->GetGuildById(queries.GuildId))
             guild->DeleteMember(playerguid, false, false, true);
 
     // remove from arena teams
-    LeaveAllArenaTeams(playerguid);
+    LeaveAllArenaTeams(playerguid, queries.ArenaTeams);
 
     // the player was uninvited already on logout so just remove from group
-    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_GROUP_MEMBER);
-    stmt->setUInt64(0, guid);
-    PreparedQueryResult resultGroup = CharacterDatabase.Query(stmt);
-
-    if (resultGroup)
-        if (Group* group = sGroupMgr->GetGroupByDbStoreId((*resultGroup)[0].GetUInt32()))
+    if (queries.GroupMember)
+        if (Group* group = sGroupMgr->GetGroupByDbStoreId((*queries.GroupMember)[0].GetUInt32()))
             RemoveFromGroup(group, playerguid);
 
     // Remove signs from petitions (also remove petitions if owner);
-    RemovePetitionsAndSigns(playerguid);
+    RemovePetitionsAndSigns(playerguid, queries.PetitionSignatures);
+
+    PreparedStatement* stmt = NULL;
 
     switch (charDeleteMethod)
     {
@@ -4011,11 +4082,7 @@ void Player::DeleteFromDB(ObjectGuid playerguid, uint32 accountId, bool updateRe
         {
             SQLTransaction trans = CharacterDatabase.BeginTransaction();
 
-            stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHAR_COD_ITEM_MAIL);
-            stmt->setUInt64(0, guid);
-            PreparedQueryResult resultMail = CharacterDatabase.Query(stmt);
-
-            if (resultMail)
+            if (PreparedQueryResult resultMail = queries.ItemMails)
             {
                 do
                 {
@@ -4055,9 +4122,8 @@ void Player::DeleteFromDB(ObjectGuid playerguid, uint32 accountId, bool updateRe
                     if (has_items)
                     {
                         // Data needs to be at first place for Item::LoadFromDB
-                        stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAILITEMS);
-                        stmt->setUInt32(0, mail_id);
-                        PreparedQueryResult resultItems = CharacterDatabase.Query(stmt);
+                        auto mailItems = queries.MailItems.find(mail_id);
+                        PreparedQueryResult resultItems = mailItems != queries.MailItems.end() ? mailItems->second : PreparedQueryResult();
                         if (resultItems)
                         {
                             do
@@ -4102,11 +4168,7 @@ void Player::DeleteFromDB(ObjectGuid playerguid, uint32 accountId, bool updateRe
 
             // Unsummon and delete for pets in world is not required: player deleted from CLI or character list with not loaded pet.
             // NOW we can finally clear other DB data related to character
-            stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHAR_PETS);
-            stmt->setUInt64(0, guid);
-            PreparedQueryResult resultPets = CharacterDatabase.Query(stmt);
-
-            if (resultPets)
+            if (PreparedQueryResult resultPets = queries.Pets)
             {
                 do
                 {
@@ -4116,10 +4178,7 @@ void Player::DeleteFromDB(ObjectGuid playerguid, uint32 accountId, bool updateRe
             }
 
             // Delete char from social list of online chars
-            stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHAR_SOCIAL);
-            stmt->setUInt64(0, guid);
-
-            if (PreparedQueryResult resultFriends = CharacterDatabase.Query(stmt))
+            if (PreparedQueryResult resultFriends = queries.Friends)
             {
                 do
                 {
@@ -4359,19 +4418,50 @@ void Player::DeleteOldCharacters(uint32 keepDays)
 {
     TC_LOG_INFO("entities.player", "Player::DeleteOldCharacters: Deleting all characters which have been deleted %u days before...", keepDays);
 
+    DeleteOldCharacters(SelectOldCharacters(keepDays));
+}
+
+std::vector<Player::OldCharacter> Player::SelectOldCharacters(uint32 keepDays)
+{
+    std::vector<OldCharacter> characters;
+
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHAR_OLD_CHARS);
     stmt->setUInt32(0, uint32(time(nullptr) - time_t(keepDays * DAY)));
-    PreparedQueryResult result = CharacterDatabase.Query(stmt);
-
-    if (result)
+    if (PreparedQueryResult result = CharacterDatabase.Query(stmt))
     {
-         TC_LOG_DEBUG("entities.player", "Player::DeleteOldCharacters: Found " UI64FMTD " character(s) to delete", result->GetRowCount());
-         do
-         {
+        characters.reserve(size_t(result->GetRowCount()));
+        do
+        {
             Field* fields = result->Fetch();
-            Player::DeleteFromDB(ObjectGuid::Create<HighGuid::Player>(fields[0].GetUInt64()), fields[1].GetUInt32(), true, true);
-         }
-         while (result->NextRow());
+            OldCharacter character;
+            character.Guid = ObjectGuid::Create<HighGuid::Player>(fields[0].GetUInt64());
+            character.AccountId = fields[1].GetUInt32();
+            characters.push_back(std::move(character));
+        }
+        while (result->NextRow());
+    }
+
+    for (OldCharacter& character : characters)
+        LoadDeleteQueries(character.Guid, true, character.Queries);
+
+    return characters;
+}
+
+void Player::DeleteOldCharacters(std::vector<OldCharacter> const& characters)
+{
+    if (characters.empty())
+        return;
+
+    TC_LOG_DEBUG("entities.player", "Player::DeleteOldCharacters: Found " SZFMTD " character(s) to delete", characters.size());
+    for (OldCharacter const& character : characters)
+    {
+        // the list may have been selected on a background thread, skip characters restored since
+        if (CharacterInfo const* characterInfo = sWorld->GetCharacterInfo(character.Guid))
+            if (!characterInfo->IsDeleted)
+                continue;
+
+        // all rows were read with the list, nothing here waits on the database
+        Player::DeleteFromDB(character.Guid, character.AccountId, true, true, character.Queries);
     }
 }
 
@@ -20892,8 +20982,12 @@ void Player::RemovePetitionsAndSigns(ObjectGuid guid)
 {
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_PETITION_SIG_BY_GUID);
     stmt->setUInt64(0, guid.GetCounter());
-    PreparedQueryResult result = CharacterDatabase.Query(stmt);
+    RemovePetitionsAndSigns(guid, CharacterDatabase.Query(stmt));
+}
 
+void Player::RemovePetitionsAndSigns(ObjectGuid guid, PreparedQueryResult result)
+{
+    PreparedStatement* stmt = NULL;
     if (result)
     {
         do                                                  // this part effectively does nothing, since the deletion / modification only takes place _after_ the PetitionQuery. Though I don't know if the result remains intact if I execute the delete query beforehand.
@@ -20932,8 +21026,11 @@ void Player::LeaveAllArenaTeams(ObjectGuid guid)
 {
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_PLAYER_ARENA_TEAMS);
     stmt->setUInt64(0, guid.GetCounter());
-    PreparedQueryResult result = CharacterDatabase.Query(stmt);
+    LeaveAllArenaTeams(guid, CharacterDatabase.Query(stmt));
+}
 
+void Player::LeaveAllArenaTeams(ObjectGuid guid, PreparedQueryResult result)
+{
     if (!result)
         return;
 
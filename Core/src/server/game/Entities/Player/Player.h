@@ -1649,9 +1649,37 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         static void SetUInt32ValueInArray(Tokenizer& data, uint16 index, uint32 value);
         static void SavePositionInDB(WorldLocation const& loc, uint16 zoneId, ObjectGuid guid, SQLTransaction& trans);
 
+        /// Rows DeleteFromDB needs to read, queried before the deletion so it can be done without waiting on the database
+        struct CharacterDeleteQueries
+        {
+            CharacterDeleteQueries() : GuildId(UI64LIT(0)) { }
+
+            ObjectGuid::LowType GuildId;
+            PreparedQueryResult ArenaTeams;
+            PreparedQueryResult GroupMember;
+            PreparedQueryResult PetitionSignatures;
+            PreparedQueryResult ItemMails;
+            std::unordered_map<uint32 /*mailId*/, PreparedQueryResult> MailItems;
+            PreparedQueryResult Pets;
+            PreparedQueryResult Friends;
+        };
+
+        struct OldCharacter
+        {
+            ObjectGuid Guid;
+            uint32 AccountId;
+            CharacterDeleteQueries Queries;
+        };
+
+        /// Only queries the character database, mail, pet and friend rows are loaded only if removeCharacter is set
+        static void LoadDeleteQueries(ObjectGuid playerguid, bool removeCharacter, CharacterDeleteQueries& queries);
         static void DeleteFromDB(ObjectGuid playerguid, uint32 accountId, bool updateRealmChars = true, bool deleteFinally = false);
+        static void DeleteFromDB(ObjectGuid playerguid, uint32 accountId, bool updateRealmChars, bool deleteFinally, CharacterDeleteQueries const& queries);
         static void DeleteOldCharacters();
         static void DeleteOldCharacters(uint32 keepDays);
+        /// Characters deleted more than keepDays ago with everything needed to remove them, only queries the character database
+        static std::vector<OldCharacter> SelectOldCharacters(uint32 keepDays);
+        static void DeleteOldCharacters(std::vector<OldCharacter> const& characters);
 
         bool m_mailsLoaded;
         bool m_mailsUpdated;
@@ -1893,12 +1921,14 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         static uint8 GetRankFromDB(ObjectGuid guid);
         ObjectGuid::LowType GetGuildIdInvited() const { return m_GuildIdInvited; }
         static void RemovePetitionsAndSigns(ObjectGuid guid);
+        static void RemovePetitionsAndSigns(ObjectGuid guid, PreparedQueryResult signatures);
 
         // Arena Team
         void SetInArenaTeam(uint32 ArenaTeamId, uint8 slot, uint8 type);
         void SetArenaTeamInfoField(uint8 slot, ArenaTeamInfoType type, uint32 value);
         static uint32 GetArenaTeamIdFromDB(ObjectGuid guid, uint8 slot);
         static void LeaveAllArenaTeams(ObjectGuid guid);
+        static void LeaveAllArenaTeams(ObjectGuid guid, PreparedQueryResult arenaTeams);
         uint32 GetArenaTeamId(uint8 slot) const { return GetUInt32Value(PLAYER_FIELD_ARENA_TEAM_INFO_1_1 + (slot * ARENA_TEAM_END) + ARENA_TEAM_ID); }
         uint32 GetArenaPersonalRating(uint8 slot) const { return GetUInt32Value(PLAYER_FIELD_ARENA_TEAM_INFO_1_1 + (slot * ARENA_TEAM_END) + ARENA_TEAM_PERSONAL_RATING); }
         void SetArenaTeamIdInvited(uint32 ArenaTeamId) { m_ArenaTeamIdInvited = ArenaTeamId; }
@@ -2299,6 +2329,10 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         // currently visible objects at player client
         GuidUnorderedSet m_clientGUIDs;
 
+        // viewpoint location at the last full visibility update, see Trinity::DelayedUnitRelocation
+        WorldLocation m_visibilityUpdateLocation;
+        uint32 m_visibilityUpdateInstanceId;
+
         bool HaveAtClient(Object const* u) const;
 
         bool IsNeverVisible() const override;
@@ -12520,10 +12520,21 @@ Unit* Unit::SelectNearbyTarget(Unit* exclude, float dist) const
     if (exclude)
         targets.remove(exclude);
 
-    // remove not LoS targets
-    for (std::list<Unit*>::iterator tIter = targets.begin(); tIter != targets.end();)
+    targets.remove_if([](Unit* target) { return target->IsTotem() || target->IsSpiritService() || target->IsCritter(); });
+
+    // remove not LoS targets, all of them are checked in one vmap query
+    std::vector<G3D::Vector3> positions;
+    positions.reserve(targets.size());
+    for (Unit* target : targets)
+        positions.emplace_back(target->GetPositionX(), target->GetPositionY(), target->GetPositionZ() + 2.f);
+
+    std::vector<bool> inLineOfSight;
+    GetMap()->isInLineOfSight(GetPositionX(), GetPositionY(), GetPositionZ() + 2.f, positions, inLineOfSight, GetPhaseMask());
+
+    std::size_t i = 0;
+    for (std::list<Unit*>::iterator tIter = targets.begin(); tIter != targets.end(); ++i)
     {
-        if (!IsWithinLOSInMap(*tIter) || (*tIter)->IsTotem() || (*tIter)->IsSpiritService() || (*tIter)->IsCritter())
+        if (!inLineOfSight[i])
             targets.erase(tIter++);
         else
             ++tIter;
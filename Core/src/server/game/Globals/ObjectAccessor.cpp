@@ -73,6 +73,69 @@ boost::shared_mutex* HashMapHolder<T>::GetLock()
     return &_lock;
 }
 
+namespace PlayerNameMapHolder
+{
+    // online players by case folded name, guarded by HashMapHolder<Player>::GetLock()
+    typedef std::unordered_map<std::wstring, Player*> MapType;
+    static MapType PlayerNameMap;
+
+    bool MakeKey(std::string const& name, std::wstring& key)
+    {
+        if (!Utf8toWStr(name, key))
+            return false;
+
+        wstrToLower(key);
+        return true;
+    }
+
+    void Insert(Player* p)
+    {
+        std::wstring key;
+        if (MakeKey(p->GetName(), key))
+            PlayerNameMap[key] = p;
+    }
+
+    void Remove(Player* p, std::string const& name)
+    {
+        std::wstring key;
+        if (!MakeKey(name, key))
+            return;
+
+        // another player with the same name may already have logged in (relog, rename)
+        MapType::iterator itr = PlayerNameMap.find(key);
+        if (itr != PlayerNameMap.end() && itr->second == p)
+            PlayerNameMap.erase(itr);
+    }
+
+    Player* Find(std::string const& name)
+    {
+        std::wstring key;
+        if (!MakeKey(name, key))
+            return nullptr;
+
+        MapType::const_iterator itr = PlayerNameMap.find(key);
+        return itr != PlayerNameMap.end() ? itr->second : nullptr;
+    }
+}
+
+template<>
+void HashMapHolder<Player>::Insert(Player* o)
+{
+    boost::unique_lock<boost::shared_mutex> lock(*GetLock());
+
+    GetContainer()[o->GetGUID()] = o;
+    PlayerNameMapHolder::Insert(o);
+}
+
+template<>
+void HashMapHolder<Player>::Remove(Player* o)
+{
+    boost::unique_lock<boost::shared_mutex> lock(*GetLock());
+
+    GetContainer().erase(o->GetGUID());
+    PlayerNameMapHolder::Remove(o, o->GetName());
+}
+
 template class TC_GAME_API HashMapHolder<Player>;
 template class TC_GAME_API HashMapHolder<Transport>;
 
@@ -226,38 +289,29 @@ Player* ObjectAccessor::FindPlayerByName(std::string const& name)
 {
     boost::shared_lock<boost::shared_mutex> lock(*HashMapHolder<Player>::GetLock());
 
-    std::string nameStr = name;
-    std::transform(nameStr.begin(), nameStr.end(), nameStr.begin(), ::tolower);
-    HashMapHolder<Player>::MapType const& m = GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator iter = m.begin(); iter != m.end(); ++iter)
-    {
-        if (!iter->second->IsInWorld())
-            continue;
-        std::string currentName = iter->second->GetName();
-        std::transform(currentName.begin(), currentName.end(), currentName.begin(), ::tolower);
-        if (nameStr.compare(currentName) == 0)
-            return iter->second;
-    }
+    Player* player = PlayerNameMapHolder::Find(name);
+    if (!player || !player->IsInWorld())
+        return NULL;
 
-    return NULL;
+    return player;
 }
 
 Player* ObjectAccessor::FindConnectedPlayerByName(std::string const& name)
 {
     boost::shared_lock<boost::shared_mutex> lock(*HashMapHolder<Player>::GetLock());
 
-    std::string nameStr = name;
-    std::transform(nameStr.begin(), nameStr.end(), nameStr.begin(), ::tolower);
-    HashMapHolder<Player>::MapType const& m = GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator iter = m.begin(); iter != m.end(); ++iter)
-    {
-        std::string currentName = iter->second->GetName();
-        std::transform(currentName.begin(), currentName.end(), currentName.begin(), ::tolower);
-        if (nameStr.compare(currentName) == 0)
-            return iter->second;
-    }
+    return PlayerNameMapHolder::Find(name);
+}
 
-    return NULL;
+void ObjectAccessor::UpdatePlayerName(Player* player, std::string const& oldName)
+{
+    boost::unique_lock<boost::shared_mutex> lock(*HashMapHolder<Player>::GetLock());
+
+    if (HashMapHolder<Player>::GetContainer().count(player->GetGUID()) == 0)
+        return;
+
+    PlayerNameMapHolder::Remove(player, oldName);
+    PlayerNameMapHolder::Insert(player);
 }
 
 HashMapHolder<Player>::MapType const& ObjectAccessor::GetPlayers()
@@ -92,6 +92,9 @@ namespace ObjectAccessor
     TC_GAME_API Player* FindConnectedPlayer(ObjectGuid const&);
     TC_GAME_API Player* FindConnectedPlayerByName(std::string const& name);
 
+    // must be called after changing the name of a player registered with AddObject
+    TC_GAME_API void UpdatePlayerName(Player* player, std::string const& oldName);
+
     // when using this, you must use the hashmapholder's lock
     TC_GAME_API HashMapHolder<Player>::MapType const& GetPlayers();
 
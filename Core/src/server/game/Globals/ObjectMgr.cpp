@@ -5450,8 +5450,6 @@ void ObjectMgr::LoadNPCText()
 //not very fast function but it is called only once a day, or on starting-up
 void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
 {
-    uint32 oldMSTime = getMSTime();
-
     time_t curTime = time(NULL);
     tm lt;
     localtime_r(&curTime, &lt);
@@ -5465,14 +5463,20 @@ void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
         stmt->setUInt64(0, basetime);
         CharacterDatabase.Execute(stmt);
     }
+
+    ExpiredMailList mails = LoadExpiredMails(basetime);
+    ReturnOrDeleteExpiredMails(mails, basetime, serverUp);
+}
+
+ExpiredMailList ObjectMgr::LoadExpiredMails(uint64 basetime)
+{
+    ExpiredMailList mails;
+
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_EXPIRED_MAIL);
     stmt->setUInt64(0, basetime);
     PreparedQueryResult result = CharacterDatabase.Query(stmt);
     if (!result)
-    {
-        TC_LOG_INFO("server.loading", ">> No expired mails found.");
-        return;                                             // any mails need to be returned or deleted
-    }
+        return mails;
 
     std::map<uint32 /*messageId*/, MailItemInfoVec> itemsCache;
     stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_EXPIRED_MAIL_ITEMS);
@@ -5490,88 +5494,114 @@ void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
         } while (items->NextRow());
     }
 
-    uint32 deletedCount = 0;
-    uint32 returnedCount = 0;
+    mails.reserve(size_t(result->GetRowCount()));
     do
     {
         Field* fields = result->Fetch();
-        Mail* m = new Mail;
-        m->messageID      = fields[0].GetUInt32();
-        m->messageType    = fields[1].GetUInt8();
-        m->sender         = fields[2].GetUInt64();
-        m->receiver       = fields[3].GetUInt64();
-        bool has_items    = fields[4].GetBool();
-        m->expire_time    = time_t(fields[5].GetUInt32());
-        m->deliver_time   = 0;
-        m->COD            = fields[6].GetUInt64();
-        m->checked        = fields[7].GetUInt8();
-        m->mailTemplateId = fields[8].GetInt16();
+        ExpiredMail mail;
+        mail.MessageId   = fields[0].GetUInt32();
+        mail.MessageType = fields[1].GetUInt8();
+        mail.Sender      = fields[2].GetUInt64();
+        mail.Receiver    = fields[3].GetUInt64();
+        mail.HasItems    = fields[4].GetBool();
+        mail.Checked     = fields[7].GetUInt8();
+        if (mail.HasItems)
+            mail.Items.swap(itemsCache[mail.MessageId]);
+
+        mails.push_back(std::move(mail));
+    }
+    while (result->NextRow());
 
+    return mails;
+}
+
+void ObjectMgr::ReturnOrDeleteExpiredMails(ExpiredMailList& mails, uint64 basetime, bool serverUp)
+{
+    uint32 oldMSTime = getMSTime();
+
+    if (mails.empty())
+    {
+        TC_LOG_INFO("server.loading", ">> No expired mails found.");
+        return;                                             // any mails need to be returned or deleted
+    }
+
+    PreparedStatement* stmt = NULL;
+    uint32 deletedCount = 0;
+    uint32 returnedCount = 0;
+    for (ExpiredMail& m : mails)
+    {
         Player* player = NULL;
         if (serverUp)
-            player = ObjectAccessor::FindConnectedPlayer(ObjectGuid::Create<HighGuid::Player>(m->receiver));
+            player = ObjectAccessor::FindConnectedPlayer(ObjectGuid::Create<HighGuid::Player>(m.Receiver));
 
         if (player && player->m_mailsLoaded)
         {                                                   // this code will run very improbably (the time is between 4 and 5 am, in game is online a player, who has old mail
             // his in mailbox and he has already listed his mails)
-            delete m;
             continue;
         }
 
-        // Delete or return mail
-        if (has_items)
+        // Delete or return mail, the mails may have been loaded on a background thread and changed since:
+        // every write only applies while the mail is still expired and the items are still attached to it
+        // the item updates match the returned mail, so all statements of a mail go in one transaction
+        SQLTransaction trans = CharacterDatabase.BeginTransaction();
+        if (m.HasItems)
         {
-            // read items from cache
-            m->items.swap(itemsCache[m->messageID]);
-
             // if it is mail from non-player, or if it's already return mail, it shouldn't be returned, but deleted
-            if (m->messageType != MAIL_NORMAL || (m->checked & (MAIL_CHECK_MASK_COD_PAYMENT | MAIL_CHECK_MASK_RETURNED)))
+            if (m.MessageType != MAIL_NORMAL || (m.Checked & (MAIL_CHECK_MASK_COD_PAYMENT | MAIL_CHECK_MASK_RETURNED)))
             {
                 // mail open and then not returned
-                for (MailItemInfoVec::iterator itr2 = m->items.begin(); itr2 != m->items.end(); ++itr2)
+                for (MailItemInfoVec::iterator itr2 = m.Items.begin(); itr2 != m.Items.end(); ++itr2)
                 {
-                    stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_ITEM_INSTANCE);
+                    stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_EXPIRED_MAIL_ITEM_INSTANCE);
                     stmt->setUInt64(0, itr2->item_guid);
-                    CharacterDatabase.Execute(stmt);
+                    stmt->setUInt32(1, m.MessageId);
+                    stmt->setUInt32(2, basetime);
+                    trans->Append(stmt);
                 }
             }
             else
             {
                 // Mail will be returned
                 stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_MAIL_RETURNED);
-                stmt->setUInt64(0, m->receiver);
-                stmt->setUInt64(1, m->sender);
+                stmt->setUInt64(0, m.Receiver);
+                stmt->setUInt64(1, m.Sender);
                 stmt->setUInt32(2, basetime + 30 * DAY);
                 stmt->setUInt32(3, basetime);
                 stmt->setUInt8 (4, uint8(MAIL_CHECK_MASK_RETURNED));
-                stmt->setUInt32(5, m->messageID);
-                CharacterDatabase.Execute(stmt);
-                for (MailItemInfoVec::iterator itr2 = m->items.begin(); itr2 != m->items.end(); ++itr2)
+                stmt->setUInt32(5, m.MessageId);
+                stmt->setUInt32(6, basetime);
+                trans->Append(stmt);
+                for (MailItemInfoVec::iterator itr2 = m.Items.begin(); itr2 != m.Items.end(); ++itr2)
                 {
                     // Update receiver in mail items for its proper delivery, and in instance_item for avoid lost item at sender delete
-                    stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_MAIL_ITEM_RECEIVER);
-                    stmt->setUInt64(0, m->sender);
+                    // only if the mail was returned above and the item is still in it
+                    stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_RETURNED_MAIL_ITEM_RECEIVER);
+                    stmt->setUInt64(0, m.Sender);
                     stmt->setUInt64(1, itr2->item_guid);
-                    CharacterDatabase.Execute(stmt);
+                    stmt->setUInt32(2, m.MessageId);
+                    stmt->setUInt64(3, m.Sender);
+                    trans->Append(stmt);
 
-                    stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_ITEM_OWNER);
-                    stmt->setUInt64(0, m->sender);
+                    stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_RETURNED_MAIL_ITEM_OWNER);
+                    stmt->setUInt64(0, m.Sender);
                     stmt->setUInt64(1, itr2->item_guid);
-                    CharacterDatabase.Execute(stmt);
+                    stmt->setUInt32(2, m.MessageId);
+                    stmt->setUInt64(3, m.Sender);
+                    trans->Append(stmt);
                 }
-                delete m;
+                CharacterDatabase.CommitTransaction(trans);
                 ++returnedCount;
                 continue;
             }
         }
 
-        stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_MAIL_BY_ID);
-        stmt->setUInt32(0, m->messageID);
-        CharacterDatabase.Execute(stmt);
-        delete m;
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_EXPIRED_MAIL_BY_ID);
+        stmt->setUInt32(0, m.MessageId);
+        stmt->setUInt32(1, basetime);
+        trans->Append(stmt);
+        CharacterDatabase.CommitTransaction(trans);
         ++deletedCount;
     }
-    while (result->NextRow());
 
     TC_LOG_INFO("server.loading", ">> Processed %u expired mails: %u deleted and %u returned in %u ms", deletedCount + returnedCount, deletedCount, returnedCount, GetMSTimeDiffToNow(oldMSTime));
 }
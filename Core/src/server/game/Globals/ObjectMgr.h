@@ -716,6 +716,20 @@ typedef std::unordered_map<uint32, std::vector<uint32 /*id*/>> TerrainPhaseInfo;
 typedef std::unordered_map<uint32, std::vector<uint32>> TerrainUIPhaseInfo; // worldmaparea swap
 typedef std::unordered_map<uint32, std::vector<PhaseInfoStruct>> PhaseInfo; // phase
 
+// mail loaded by ObjectMgr::LoadExpiredMails, possibly on a background thread
+struct ExpiredMail
+{
+    uint32 MessageId;
+    uint8 MessageType;
+    ObjectGuid::LowType Sender;
+    ObjectGuid::LowType Receiver;
+    bool HasItems;
+    uint8 Checked;
+    MailItemInfoVec Items;
+};
+
+typedef std::vector<ExpiredMail> ExpiredMailList;
+
 class PlayerDumpReader;
 
 class TC_GAME_API ObjectMgr
@@ -1104,6 +1118,9 @@ class TC_GAME_API ObjectMgr
         }
 
         void ReturnOrDeleteOldMails(bool serverUp);
+        /// Only queries the character database, safe to call from any thread
+        static ExpiredMailList LoadExpiredMails(uint64 basetime);
+        void ReturnOrDeleteExpiredMails(ExpiredMailList& mails, uint64 basetime, bool serverUp);
 
         CreatureBaseStats const* GetCreatureBaseStats(uint8 level, uint8 unitClass);
 
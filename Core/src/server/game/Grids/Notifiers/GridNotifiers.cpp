@@ -24,11 +24,33 @@
 #include "Transport.h"
 #include "ObjectAccessor.h"
 #include "CellImpl.h"
+#include "Metric.h"
+#include "World.h"
 
 using namespace Trinity;
 
+std::atomic<uint32> VisibilityStatistics::Checks(0);
+std::atomic<uint32> VisibilityStatistics::Skipped(0);
+std::atomic<uint32> VisibilityStatistics::FullUpdates(0);
+std::atomic<uint32> VisibilityStatistics::IncrementalUpdates(0);
+
+void VisibilityStatistics::LogMetrics()
+{
+    TC_METRIC_VALUE("visibility_checks", Checks.exchange(0, std::memory_order_relaxed));
+    TC_METRIC_VALUE("visibility_checks_skipped", Skipped.exchange(0, std::memory_order_relaxed));
+    TC_METRIC_VALUE("visibility_full_updates", FullUpdates.exchange(0, std::memory_order_relaxed));
+    TC_METRIC_VALUE("visibility_incremental_updates", IncrementalUpdates.exchange(0, std::memory_order_relaxed));
+}
+
 void VisibleNotifier::SendToSelf()
 {
+    VisibilityStatistics::Checks.fetch_add(i_checks, std::memory_order_relaxed);
+    VisibilityStatistics::Skipped.fetch_add(i_skipped, std::memory_order_relaxed);
+    if (i_band < 0.0f)
+        VisibilityStatistics::FullUpdates.fetch_add(1, std::memory_order_relaxed);
+    else
+        VisibilityStatistics::IncrementalUpdates.fetch_add(1, std::memory_order_relaxed);
+
     // at this moment i_clientGUIDs have guids that not iterate at grid level checks
     // but exist one case when this possible and object not out of range: transports
     if (Transport* transport = i_player.GetTransport())
@@ -149,6 +171,7 @@ void PlayerRelocationNotifier::Visit(PlayerMapType &m)
 
         vis_guids.erase(player->GetGUID());
 
+        ++i_checks;
         i_player.UpdateVisibilityOf(player, i_data, i_visibleNow);
 
         if (player->m_seer->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
@@ -168,7 +191,13 @@ void PlayerRelocationNotifier::Visit(CreatureMapType &m)
 
         vis_guids.erase(c->GetGUID());
 
-        i_player.UpdateVisibilityOf(c, i_data, i_visibleNow);
+        if (IsVisibilityUnchanged(c))
+            ++i_skipped;
+        else
+        {
+            ++i_checks;
+            i_player.UpdateVisibilityOf(c, i_data, i_visibleNow);
+        }
 
         if (relocated_for_ai && !c->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
             CreatureUnitRelocationWorker(c, &i_player);
@@ -238,7 +267,25 @@ void DelayedUnitRelocation::Visit(PlayerMapType &m)
         Cell cell2(pair2);
         //cell.SetNoCreate(); need load cells around viewPoint or player, that's why its commented
 
-        PlayerRelocationNotifier relocate(*player);
+        // while the player stays close to where everything was last checked, only objects
+        // that may have crossed the visibility range need to be checked again
+        float band = -1.0f;
+        float incrementalDistance = World::GetVisibilityIncrementalDistance();
+        if (incrementalDistance > 0.0f && player == viewPoint && player->IsAlive() &&
+            player->m_visibilityUpdateLocation.GetMapId() == player->GetMapId() && player->m_visibilityUpdateInstanceId == player->GetInstanceId())
+        {
+            float moved = player->GetExactDist2d(&player->m_visibilityUpdateLocation);
+            if (moved <= incrementalDistance)
+                band = moved + incrementalDistance;
+        }
+
+        if (band < 0.0f)
+        {
+            player->m_visibilityUpdateLocation.WorldRelocate(player->GetMapId(), viewPoint->GetPositionX(), viewPoint->GetPositionY(), viewPoint->GetPositionZ());
+            player->m_visibilityUpdateInstanceId = player->GetInstanceId();
+        }
+
+        PlayerRelocationNotifier relocate(*player, band);
         TypeContainerVisitor<PlayerRelocationNotifier, WorldTypeMapContainer > c2world_relocation(relocate);
         TypeContainerVisitor<PlayerRelocationNotifier, GridTypeMapContainer >  c2grid_relocation(relocate);
 
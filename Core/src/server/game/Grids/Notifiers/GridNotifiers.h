@@ -21,6 +21,7 @@
 
 #include "ObjectGridLoader.h"
 #include "UpdateData.h"
+#include <atomic>
 #include <iostream>
 
 #include "Corpse.h"
@@ -40,15 +41,33 @@ class Player;
 
 namespace Trinity
 {
+    // visibility checks done by all maps, sent to the metric database once per world update
+    struct TC_GAME_API VisibilityStatistics
+    {
+        static std::atomic<uint32> Checks;
+        static std::atomic<uint32> Skipped;
+        static std::atomic<uint32> FullUpdates;
+        static std::atomic<uint32> IncrementalUpdates;
+
+        static void LogMetrics();
+    };
+
     struct TC_GAME_API VisibleNotifier
     {
         Player &i_player;
         UpdateData i_data;
         std::set<Unit*> i_visibleNow;
         GuidUnorderedSet vis_guids;
-
-        VisibleNotifier(Player &player) : i_player(player), i_data(player.GetMapId()), vis_guids(player.m_clientGUIDs) { }
+        float i_band;                                       // negative for a full update
+        uint32 i_checks;
+        uint32 i_skipped;
+
+        // with band >= 0 only objects whose distance is within band of the visibility range are checked,
+        // objects known to the client but not visited are sent out of range in both modes
+        VisibleNotifier(Player &player, float band = -1.0f) : i_player(player), i_data(player.GetMapId()),
+            vis_guids(player.m_clientGUIDs), i_band(band), i_checks(0), i_skipped(0) { }
         template<class T> void Visit(GridRefManager<T> &m);
+        template<class T> bool IsVisibilityUnchanged(T* target) const;
         void SendToSelf(void);
     };
 
@@ -65,7 +84,7 @@ namespace Trinity
 
     struct TC_GAME_API PlayerRelocationNotifier : public VisibleNotifier
     {
-        PlayerRelocationNotifier(Player &player) : VisibleNotifier(player) { }
+        PlayerRelocationNotifier(Player &player, float band = -1.0f) : VisibleNotifier(player, band) { }
 
         template<class T> void Visit(GridRefManager<T> &m) { VisibleNotifier::Visit(m); }
         void Visit(CreatureMapType &);
@@ -34,10 +34,40 @@ inline void Trinity::VisibleNotifier::Visit(GridRefManager<T> &m)
     for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
         vis_guids.erase(iter->GetSource()->GetGUID());
+        if (IsVisibilityUnchanged(iter->GetSource()))
+        {
+            ++i_skipped;
+            continue;
+        }
+
+        ++i_checks;
         i_player.UpdateVisibilityOf(iter->GetSource(), i_data, i_visibleNow);
     }
 }
 
+namespace Trinity
+{
+    // objects that can appear or disappear without moving, corpses and despawned gameobjects
+    inline bool MayDespawnInPlace(WorldObject const* /*target*/) { return false; }
+    inline bool MayDespawnInPlace(Creature const* target) { return !target->IsAlive(); }
+    inline bool MayDespawnInPlace(GameObject const* target) { return !target->isSpawned(); }
+}
+
+template<class T>
+inline bool Trinity::VisibleNotifier::IsVisibilityUnchanged(T* target) const
+{
+    if (i_band < 0.0f)
+        return false;
+
+    // moved itself since the last update, or visibility does not only depend on distance
+    if (target->isNeedNotify(NOTIFY_VISIBILITY_CHANGED) || target->m_stealth.GetFlags() || target->m_invisibility.GetFlags() || MayDespawnInPlace(target))
+        return false;
+
+    // same bound as WorldObject::IsWithinDist used by CanSeeOrDetect
+    float bound = i_player.GetSightRange(target) + i_player.GetObjectSize() + target->GetObjectSize();
+    return std::fabs(i_player.GetExactDist2d(target) - bound) > i_band;
+}
+
 // SEARCHERS & LIST SEARCHERS & WORKERS
 
 // WorldObject searchers & workers
@@ -41,6 +41,31 @@ void GuildMgr::SaveGuilds()
 {
     for (GuildContainer::iterator itr = GuildStore.begin(); itr != GuildStore.end(); ++itr)
         itr->second->SaveToDB();
+
+    GuildSaveQueue.clear();
+}
+
+void GuildMgr::QueueGuildSaves()
+{
+    GuildSaveQueue.clear();
+    GuildSaveQueue.reserve(GuildStore.size());
+    for (GuildContainer::const_iterator itr = GuildStore.begin(); itr != GuildStore.end(); ++itr)
+        GuildSaveQueue.push_back(itr->first);
+}
+
+void GuildMgr::SaveQueuedGuilds(uint32 count)
+{
+    while (count && !GuildSaveQueue.empty())
+    {
+        // guilds disbanded since QueueGuildSaves are skipped
+        if (Guild* guild = GetGuildById(GuildSaveQueue.back()))
+        {
+            guild->SaveToDB();
+            --count;
+        }
+
+        GuildSaveQueue.pop_back();
+    }
 }
 
 ObjectGuid::LowType GuildMgr::GenerateGuildId()
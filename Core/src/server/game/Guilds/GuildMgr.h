@@ -42,6 +42,9 @@ public:
     void RemoveGuild(ObjectGuid::LowType guildId);
 
     void SaveGuilds();
+    /// Spreads a save of all guilds over the next calls of SaveQueuedGuilds
+    void QueueGuildSaves();
+    void SaveQueuedGuilds(uint32 count);
 
     void ResetReputationCaps();
 
@@ -56,6 +59,7 @@ protected:
     ObjectGuid::LowType NextGuildId;
     GuildContainer GuildStore;
     std::vector<GuildReward> GuildRewards;
+    std::vector<ObjectGuid::LowType> GuildSaveQueue;
 };
 
 #define sGuildMgr GuildMgr::instance()
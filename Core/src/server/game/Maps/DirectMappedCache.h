@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2008-2016 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DirectMappedCache_h__
+#define DirectMappedCache_h__
+
+#include "Define.h"
+#include <mutex>
+#include <vector>
+
+/*
+ * Fixed size cache of Value, each hash maps to exactly one slot and a new value replaces
+ * whatever was stored there. Invalidate empties all slots at once by starting a new generation.
+ * Values are copied in and out under a lock, the cache is shared by the map update threads.
+ */
+template<class Value>
+class DirectMappedCache
+{
+    public:
+        /// @param size number of entries, rounded up to a power of two, 0 disables the cache
+        explicit DirectMappedCache(uint32 size) : _generation(1)
+        {
+            if (!size)
+                return;
+
+            uint32 slots = 1;
+            while (slots < size)
+                slots <<= 1;
+
+            _entries.resize(slots, Entry());
+        }
+
+        bool IsEnabled() const { return !_entries.empty(); }
+
+        /// @return false if the slot of hash is empty, value is set to what it holds otherwise
+        bool Get(std::size_t hash, Value& value) const
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            Entry const& entry = _entries[hash & (_entries.size() - 1)];
+            if (entry.Generation != _generation)
+                return false;
+
+            value = entry.Stored;
+            return true;
+        }
+
+        void Store(std::size_t hash, Value const& value)
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            Entry& entry = _entries[hash & (_entries.size() - 1)];
+            entry.Stored = value;
+            entry.Generation = _generation;
+        }
+
+        void Invalidate()
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            if (++_generation == 0)
+            {
+                // wrapped around, old entries could match again
+                for (Entry& entry : _entries)
+                    entry.Generation = 0;
+                _generation = 1;
+            }
+        }
+
+    private:
+        struct Entry
+        {
+            Entry() : Stored(), Generation(0) { }
+
+            Value Stored;
+            uint32 Generation;
+        };
+
+        mutable std::mutex _lock;
+        std::vector<Entry> _entries;
+        uint32 _generation;                                 // entries of older generations are empty
+};
+
+#endif // DirectMappedCache_h__
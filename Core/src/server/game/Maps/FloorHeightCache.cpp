@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2008-2016 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FloorHeightCache.h"
+#include <cmath>
+#include <cstring>
+
+std::size_t FloorHeightCache::GetHash(float x, float y)
+{
+    uint32 bits[2];
+    memcpy(&bits[0], &x, sizeof(float));
+    memcpy(&bits[1], &y, sizeof(float));
+
+    uint64 hash = (uint64(bits[0]) << 32 | bits[1]) * UI64LIT(0x9E3779B97F4A7C15);
+    return std::size_t(hash >> 32);
+}
+
+bool FloorHeightCache::Get(float x, float y, float z, float maxSearchDist, float invalidHeight, float& height) const
+{
+    if (!IsEnabled() || !std::isfinite(z) || !std::isfinite(maxSearchDist))
+        return false;
+
+    Entry entry;
+    if (!_cache.Get(GetHash(x, y), entry) || entry.X != x || entry.Y != y)
+        return false;
+
+    // nothing is known above the cached ray, and a ray starting on the cached floor does not hit it
+    if (z > entry.Top || z <= entry.Bottom)
+        return false;
+
+    if (entry.Hit)
+    {
+        // the cached floor is the first surface below z
+        height = z - entry.Bottom < maxSearchDist ? entry.Bottom : invalidHeight;
+        return true;
+    }
+
+    // the ray ends inside the empty range
+    if (z - maxSearchDist < entry.Bottom)
+        return false;
+
+    height = invalidHeight;
+    return true;
+}
+
+void FloorHeightCache::Store(float x, float y, float z, float maxSearchDist, float invalidHeight, float height)
+{
+    if (!IsEnabled() || !std::isfinite(z) || !std::isfinite(maxSearchDist))
+        return;
+
+    Entry entry;
+    entry.X = x;
+    entry.Y = y;
+    entry.Top = z;
+    entry.Hit = height > invalidHeight;
+    entry.Bottom = entry.Hit ? height : z - maxSearchDist;
+    _cache.Store(GetHash(x, y), entry);
+}
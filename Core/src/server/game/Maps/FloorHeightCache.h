@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2008-2016 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FloorHeightCache_h__
+#define FloorHeightCache_h__
+
+#include "DirectMappedCache.h"
+
+/*
+ * Remembers the vmap floor found under a position of one map. An entry keeps the ray that
+ * was cast for an exact x, y column: the floor it hit and the range it passed through
+ * without hitting anything. Any later ray for the same column that starts and ends inside
+ * what is known gets the same answer without walking the tree, so results are exact.
+ */
+class TC_GAME_API FloorHeightCache
+{
+    public:
+        /// @param size see DirectMappedCache
+        explicit FloorHeightCache(uint32 size) : _cache(size) { }
+
+        bool IsEnabled() const { return _cache.IsEnabled(); }
+
+        /// @return true if the result of a downward ray from z over maxSearchDist is known, height is set to it or to invalidHeight
+        bool Get(float x, float y, float z, float maxSearchDist, float invalidHeight, float& height) const;
+        /// @param height result of the ray, invalidHeight if nothing was hit
+        void Store(float x, float y, float z, float maxSearchDist, float invalidHeight, float height);
+
+        /// Drops all cached results, used when terrain tiles of the map are loaded or unloaded
+        void Invalidate() { _cache.Invalidate(); }
+
+    private:
+        struct Entry
+        {
+            float X;
+            float Y;
+            float Top;                                      // start of the ray
+            float Bottom;                                   // floor that was hit, or the end of the ray
+            bool Hit;
+        };
+
+        static std::size_t GetHash(float x, float y);
+
+        DirectMappedCache<Entry> _cache;
+};
+
+#endif // FloorHeightCache_h__
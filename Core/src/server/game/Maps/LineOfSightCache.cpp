@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2008-2016 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LineOfSightCache.h"
+#include "GridDefines.h"
+#include <algorithm>
+#include <cmath>
+
+float const LineOfSightCache::CellSize = 0.5f;
+
+bool LineOfSightCache::Key::operator==(Key const& right) const
+{
+    return std::equal(std::begin(Cells), std::end(Cells), std::begin(right.Cells));
+}
+
+bool LineOfSightCache::MakeKey(float x1, float y1, float z1, float x2, float y2, float z2, Key& key)
+{
+    if (!Trinity::IsValidMapCoord(x1, y1, z1) || !Trinity::IsValidMapCoord(x2, y2, z2))
+        return false;
+
+    int32 first[3] = { int32(std::floor(x1 / CellSize)), int32(std::floor(y1 / CellSize)), int32(std::floor(z1 / CellSize)) };
+    int32 second[3] = { int32(std::floor(x2 / CellSize)), int32(std::floor(y2 / CellSize)), int32(std::floor(z2 / CellSize)) };
+
+    // vmap triangles are hit from both sides, a->b and b->a share the entry
+    if (std::lexicographical_compare(std::begin(second), std::end(second), std::begin(first), std::end(first)))
+        std::swap(first, second);
+
+    std::copy(std::begin(first), std::end(first), key.Cells);
+    std::copy(std::begin(second), std::end(second), key.Cells + 3);
+    return true;
+}
+
+std::size_t LineOfSightCache::GetHash(Key const& key)
+{
+    uint64 hash = 0;
+    for (int32 cell : key.Cells)
+        hash = (hash ^ uint32(cell)) * UI64LIT(0x100000001B3);
+
+    return std::size_t(hash ^ (hash >> 32));
+}
+
+bool LineOfSightCache::Get(float x1, float y1, float z1, float x2, float y2, float z2, bool& result) const
+{
+    Key key;
+    if (!IsEnabled() || !MakeKey(x1, y1, z1, x2, y2, z2, key))
+        return false;
+
+    Entry entry;
+    if (!_cache.Get(GetHash(key), entry) || !(entry.Cells == key))
+        return false;
+
+    result = entry.Result;
+    return true;
+}
+
+void LineOfSightCache::Store(float x1, float y1, float z1, float x2, float y2, float z2, bool result)
+{
+    Key key;
+    if (!IsEnabled() || !MakeKey(x1, y1, z1, x2, y2, z2, key))
+        return;
+
+    Entry entry;
+    entry.Cells = key;
+    entry.Result = result;
+    _cache.Store(GetHash(key), entry);
+}
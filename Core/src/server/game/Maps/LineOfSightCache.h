@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2008-2016 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LineOfSightCache_h__
+#define LineOfSightCache_h__
+
+#include "DirectMappedCache.h"
+
+/*
+ * Remembers static (vmap) line of sight results of one map, keyed by the cells of both endpoints.
+ * Gameobject models are not cached, they can move and change state every tick.
+ */
+class TC_GAME_API LineOfSightCache
+{
+    public:
+        /// Edge length of the cells endpoints are rounded to
+        static float const CellSize;
+
+        /// @param size see DirectMappedCache
+        explicit LineOfSightCache(uint32 size) : _cache(size) { }
+
+        bool IsEnabled() const { return _cache.IsEnabled(); }
+
+        /// @return true if a result was cached for the cells of both endpoints, in either direction
+        bool Get(float x1, float y1, float z1, float x2, float y2, float z2, bool& result) const;
+        void Store(float x1, float y1, float z1, float x2, float y2, float z2, bool result);
+
+        /// Drops all cached results, used when terrain tiles of the map are loaded or unloaded
+        void Invalidate() { _cache.Invalidate(); }
+
+    private:
+        struct Key
+        {
+            int32 Cells[6];
+
+            bool operator==(Key const& right) const;
+        };
+
+        struct Entry
+        {
+            Key Cells;
+            bool Result;
+        };
+
+        static bool MakeKey(float x1, float y1, float z1, float x2, float y2, float z2, Key& key);
+        static std::size_t GetHash(Key const& key);
+
+        DirectMappedCache<Entry> _cache;
+};
+
+#endif // LineOfSightCache_h__
@@ -21,6 +21,7 @@
 #include "Battleground.h"
 #include "MMapFactory.h"
 #include "CellImpl.h"
+#include "DBFileMapping.h"
 #include "DisableMgr.h"
 #include "DynamicTree.h"
 #include "GridNotifiers.h"
@@ -30,6 +31,7 @@
 #include "InstancePackets.h"
 #include "InstanceScript.h"
 #include "MapInstanced.h"
+#include "Metric.h"
 #include "MiscPackets.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
@@ -147,6 +149,8 @@ void Map::LoadVMap(int gx, int gy)
     switch (vmapLoadResult)
     {
         case VMAP::VMAP_LOAD_RESULT_OK:
+            _lineOfSightCache.Invalidate();
+            _floorHeightCache.Invalidate();
             TC_LOG_DEBUG("maps", "VMAP loaded name:%s, id:%d, x:%d, y:%d (vmap rep.: x:%d, y:%d)", GetMapName(), GetId(), gx, gy, gx, gy);
             break;
         case VMAP::VMAP_LOAD_RESULT_ERROR:
@@ -238,7 +242,8 @@ i_mapEntry(sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode), i_InstanceId(Inst
 m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
 m_VisibilityNotifyPeriod(DEFAULT_VISIBILITY_NOTIFY_PERIOD),
 m_activeNonPlayersIter(m_activeNonPlayers.end()), _transportsUpdateIter(_transports.end()),
-i_gridExpiry(expiry),
+i_gridExpiry(expiry), _lineOfSightCache(_parent ? 0 : sWorld->getIntConfig(CONFIG_LINE_OF_SIGHT_CACHE_SIZE)),
+_floorHeightCache(_parent ? 0 : sWorld->getIntConfig(CONFIG_FLOOR_HEIGHT_CACHE_SIZE)),
 i_scriptLock(false), _defaultLight(GetDefaultMapLight(id))
 {
     m_parentMap = (_parent ? _parent : this);
@@ -1594,6 +1599,8 @@ bool Map::UnloadGrid(NGridType& ngrid, bool unloadAll)
             }
             VMAP::VMapFactory::createOrGetVMapManager()->unloadMap(GetId(), gx, gy);
             MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(GetId(), gx, gy);
+            _lineOfSightCache.Invalidate();
+            _floorHeightCache.Invalidate();
         }
         else
             ((MapInstanced*)m_parentMap)->RemoveGridMapReference(GridCoord(gx, gy));
@@ -1691,101 +1698,195 @@ GridMap::~GridMap()
     unloadData();
 }
 
+namespace
+{
+    std::atomic<bool> GridMapMemoryMapped(false);
+}
+
+void GridMap::SetMemoryMapped(bool enable)
+{
+    GridMapMemoryMapped = enable;
+}
+
+bool GridMap::IsMemoryMapped()
+{
+    return GridMapMemoryMapped;
+}
+
+// Reads a .map file with stdio or from a read only memory mapping
+class GridMapFile
+{
+    public:
+        explicit GridMapFile(FILE* file) : _file(file), _mapping(nullptr), _mappedArrays(0) { }
+        explicit GridMapFile(DBFileMapping* mapping) : _file(nullptr), _mapping(mapping), _mappedArrays(0) { }
+
+        bool Seek(uint32 offset)
+        {
+            if (_mapping)
+                return _mapping->Seek(offset);
+
+            return fseek(_file, offset, SEEK_SET) == 0;
+        }
+
+        bool Read(void* dest, std::size_t size)
+        {
+            if (_mapping)
+            {
+                unsigned char const* bytes = _mapping->Consume(size);
+                if (!bytes)
+                    return false;
+
+                memcpy(dest, bytes, size);
+                return true;
+            }
+
+            return fread(dest, size, 1, _file) == 1;
+        }
+
+        /// Points data into the mapping if it is aligned there, otherwise reads a copy allocated with new[]
+        template<class T>
+        bool ReadArray(T const*& data, uint32 count)
+        {
+            if (_mapping)
+            {
+                unsigned char const* bytes = _mapping->Consume(count * sizeof(T));
+                if (!bytes)
+                    return false;
+
+                if (reinterpret_cast<uintptr_t>(bytes) % alignof(T) == 0)
+                {
+                    data = reinterpret_cast<T const*>(bytes);
+                    ++_mappedArrays;
+                    return true;
+                }
+
+                T* copy = new T[count];
+                memcpy(copy, bytes, count * sizeof(T));
+                data = copy;
+                return true;
+            }
+
+            T* copy = new T[count];
+            data = copy;
+            return fread(copy, sizeof(T), count, _file) == count;
+        }
+
+        uint32 GetMappedArrayCount() const { return _mappedArrays; }
+
+    private:
+        FILE* _file;
+        DBFileMapping* _mapping;
+        uint32 _mappedArrays;
+};
+
 bool GridMap::loadData(const char* filename)
 {
     // Unload old data if exist
     unloadData();
 
     map_fileheader header;
-    // Not return error if file not found
-    FILE* in = fopen(filename, "rb");
-    if (!in)
-        return true;
+    FILE* in = nullptr;
+    if (IsMemoryMapped())
+    {
+        _mapping.reset(new DBFileMapping());
+        if (!_mapping->Open(filename))
+        {
+            // Not return error if file not found
+            bool missing = _mapping->IsFileMissing();
+            if (!missing)
+                TC_LOG_ERROR("maps", "Could not map file '%s': %s", filename, _mapping->GetError());
 
-    if (fread(&header, sizeof(header), 1, in) != 1)
+            _mapping.reset();
+            return missing;
+        }
+    }
+    else
     {
-        fclose(in);
-        return false;
+        in = fopen(filename, "rb");
+        if (!in)
+        {
+            // Not return error if file not found
+            if (errno == ENOENT)
+                return true;
+
+            TC_LOG_ERROR("maps", "Could not open file '%s': %s", filename, strerror(errno));
+            return false;
+        }
     }
 
-    if (header.mapMagic.asUInt == MapMagic.asUInt && header.versionMagic.asUInt == MapVersionMagic.asUInt)
+    GridMapFile file = in ? GridMapFile(in) : GridMapFile(_mapping.get());
+    bool result = false;
+    if (!file.Read(&header, sizeof(header)))
+        result = false;
+    else if (header.mapMagic.asUInt == MapMagic.asUInt && header.versionMagic.asUInt == MapVersionMagic.asUInt)
     {
         // load up area data
-        if (header.areaMapOffset && !loadAreaData(in, header.areaMapOffset, header.areaMapSize))
-        {
+        if (header.areaMapOffset && !loadAreaData(file, header.areaMapOffset, header.areaMapSize))
             TC_LOG_ERROR("maps", "Error loading map area data\n");
-            fclose(in);
-            return false;
-        }
         // load up height data
-        if (header.heightMapOffset && !loadHeightData(in, header.heightMapOffset, header.heightMapSize))
-        {
+        else if (header.heightMapOffset && !loadHeightData(file, header.heightMapOffset, header.heightMapSize))
             TC_LOG_ERROR("maps", "Error loading map height data\n");
-            fclose(in);
-            return false;
-        }
         // load up liquid data
-        if (header.liquidMapOffset && !loadLiquidData(in, header.liquidMapOffset, header.liquidMapSize))
-        {
+        else if (header.liquidMapOffset && !loadLiquidData(file, header.liquidMapOffset, header.liquidMapSize))
             TC_LOG_ERROR("maps", "Error loading map liquids data\n");
-            fclose(in);
-            return false;
-        }
-        fclose(in);
-        return true;
+        else
+            result = true;
     }
+    else
+        TC_LOG_ERROR("maps", "Map file '%s' is from an incompatible map version (%.*s %.*s), %.*s %.*s is expected. Please recreate using the mapextractor.",
+            filename, 4, header.mapMagic.asChar, 4, header.versionMagic.asChar, 4, MapMagic.asChar, 4, MapVersionMagic.asChar);
 
-    TC_LOG_ERROR("maps", "Map file '%s' is from an incompatible map version (%.*s %.*s), %.*s %.*s is expected. Please recreate using the mapextractor.",
-        filename, 4, header.mapMagic.asChar, 4, header.versionMagic.asChar, 4, MapMagic.asChar, 4, MapVersionMagic.asChar);
-    fclose(in);
-    return false;
+    if (in)
+        fclose(in);
+    // flat tiles or misaligned data, nothing to share
+    else if (result && !file.GetMappedArrayCount())
+        _mapping.reset();
+
+    return result;
+}
+
+template<class T>
+void GridMap::releaseArray(T const*& data)
+{
+    if (!_mapping || data < reinterpret_cast<T const*>(_mapping->GetData()) || data >= reinterpret_cast<T const*>(_mapping->GetData() + _mapping->GetSize()))
+        delete[] data;
+
+    data = nullptr;
 }
 
 void GridMap::unloadData()
 {
-    delete[] _areaMap;
-    delete[] m_V9;
-    delete[] m_V8;
-    delete[] _maxHeight;
-    delete[] _minHeight;
-    delete[] _liquidEntry;
-    delete[] _liquidFlags;
-    delete[] _liquidMap;
-    _areaMap = nullptr;
-    m_V9 = nullptr;
-    m_V8 = nullptr;
-    _maxHeight = nullptr;
-    _minHeight = nullptr;
-    _liquidEntry = nullptr;
-    _liquidFlags = nullptr;
-    _liquidMap  = nullptr;
+    releaseArray(_areaMap);
+    releaseArray(m_V9);
+    releaseArray(m_V8);
+    releaseArray(_maxHeight);
+    releaseArray(_minHeight);
+    releaseArray(_liquidEntry);
+    releaseArray(_liquidFlags);
+    releaseArray(_liquidMap);
+    _mapping.reset();
     _gridGetHeight = &GridMap::getHeightFromFlat;
 }
 
-bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadAreaData(GridMapFile& in, uint32 offset, uint32 /*size*/)
 {
     map_areaHeader header;
-    fseek(in, offset, SEEK_SET);
-
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.fourcc != MapAreaMagic.asUInt)
+    if (!in.Seek(offset) || !in.Read(&header, sizeof(header)) || header.fourcc != MapAreaMagic.asUInt)
         return false;
 
     _gridArea = header.gridArea;
     if (!(header.flags & MAP_AREA_NO_AREA))
     {
-        _areaMap = new uint16[16 * 16];
-        if (fread(_areaMap, sizeof(uint16), 16*16, in) != 16*16)
+        if (!in.ReadArray(_areaMap, 16 * 16))
             return false;
     }
     return true;
 }
 
-bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHeightData(GridMapFile& in, uint32 offset, uint32 /*size*/)
 {
     map_heightHeader header;
-    fseek(in, offset, SEEK_SET);
-
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.fourcc != MapHeightMagic.asUInt)
+    if (!in.Seek(offset) || !in.Read(&header, sizeof(header)) || header.fourcc != MapHeightMagic.asUInt)
         return false;
 
     _gridHeight = header.gridHeight;
@@ -1793,30 +1894,24 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     {
         if ((header.flags & MAP_HEIGHT_AS_INT16))
         {
-            m_uint16_V9 = new uint16 [129*129];
-            m_uint16_V8 = new uint16 [128*128];
-            if (fread(m_uint16_V9, sizeof(uint16), 129*129, in) != 129*129 ||
-                fread(m_uint16_V8, sizeof(uint16), 128*128, in) != 128*128)
+            if (!in.ReadArray(m_uint16_V9, 129*129) ||
+                !in.ReadArray(m_uint16_V8, 128*128))
                 return false;
             _gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
             _gridGetHeight = &GridMap::getHeightFromUint16;
         }
         else if ((header.flags & MAP_HEIGHT_AS_INT8))
         {
-            m_uint8_V9 = new uint8 [129*129];
-            m_uint8_V8 = new uint8 [128*128];
-            if (fread(m_uint8_V9, sizeof(uint8), 129*129, in) != 129*129 ||
-                fread(m_uint8_V8, sizeof(uint8), 128*128, in) != 128*128)
+            if (!in.ReadArray(m_uint8_V9, 129*129) ||
+                !in.ReadArray(m_uint8_V8, 128*128))
                 return false;
             _gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
             _gridGetHeight = &GridMap::getHeightFromUint8;
         }
         else
         {
-            m_V9 = new float [129*129];
-            m_V8 = new float [128*128];
-            if (fread(m_V9, sizeof(float), 129*129, in) != 129*129 ||
-                fread(m_V8, sizeof(float), 128*128, in) != 128*128)
+            if (!in.ReadArray(m_V9, 129*129) ||
+                !in.ReadArray(m_V8, 128*128))
                 return false;
             _gridGetHeight = &GridMap::getHeightFromFloat;
         }
@@ -1826,22 +1921,18 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
 
     if (header.flags & MAP_HEIGHT_HAS_FLIGHT_BOUNDS)
     {
-        _maxHeight = new int16[3 * 3];
-        _minHeight = new int16[3 * 3];
-        if (fread(_maxHeight, sizeof(int16), 3 * 3, in) != 3 * 3 ||
-            fread(_minHeight, sizeof(int16), 3 * 3, in) != 3 * 3)
+        if (!in.ReadArray(_maxHeight, 3 * 3) ||
+            !in.ReadArray(_minHeight, 3 * 3))
             return false;
     }
 
     return true;
 }
 
-bool GridMap::loadLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadLiquidData(GridMapFile& in, uint32 offset, uint32 /*size*/)
 {
     map_liquidHeader header;
-    fseek(in, offset, SEEK_SET);
-
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.fourcc != MapLiquidMagic.asUInt)
+    if (!in.Seek(offset) || !in.Read(&header, sizeof(header)) || header.fourcc != MapLiquidMagic.asUInt)
         return false;
 
     _liquidType   = header.liquidType;
@@ -1853,18 +1944,15 @@ bool GridMap::loadLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
 
     if (!(header.flags & MAP_LIQUID_NO_TYPE))
     {
-        _liquidEntry = new uint16[16*16];
-        if (fread(_liquidEntry, sizeof(uint16), 16*16, in) != 16*16)
+        if (!in.ReadArray(_liquidEntry, 16*16))
             return false;
 
-        _liquidFlags = new uint8[16*16];
-        if (fread(_liquidFlags, sizeof(uint8), 16*16, in) != 16*16)
+        if (!in.ReadArray(_liquidFlags, 16*16))
             return false;
     }
     if (!(header.flags & MAP_LIQUID_NO_HEIGHT))
     {
-        _liquidMap = new float[uint32(_liquidWidth) * uint32(_liquidHeight)];
-        if (fread(_liquidMap, sizeof(float), _liquidWidth*_liquidHeight, in) != (uint32(_liquidWidth) * uint32(_liquidHeight)))
+        if (!in.ReadArray(_liquidMap, uint32(_liquidWidth) * uint32(_liquidHeight)))
             return false;
     }
     return true;
@@ -1985,7 +2073,7 @@ float GridMap::getHeightFromUint8(float x, float y) const
     y_int&=(MAP_RESOLUTION - 1);
 
     int32 a, b, c;
-    uint8 *V9_h1_ptr = &m_uint8_V9[x_int*128 + x_int + y_int];
+    uint8 const* V9_h1_ptr = &m_uint8_V9[x_int*128 + x_int + y_int];
     if (x+y < 1)
     {
         if (x > y)
@@ -2052,7 +2140,7 @@ float GridMap::getHeightFromUint16(float x, float y) const
     y_int&=(MAP_RESOLUTION - 1);
 
     int32 a, b, c;
-    uint16 *V9_h1_ptr = &m_uint16_V9[x_int*128 + x_int + y_int];
+    uint16 const* V9_h1_ptr = &m_uint16_V9[x_int*128 + x_int + y_int];
     if (x+y < 1)
     {
         if (x > y)
@@ -2338,7 +2426,16 @@ float Map::GetHeight(float x, float y, float z, bool checkVMap /*= true*/, float
     {
         VMAP::IVMapManager* vmgr = VMAP::VMapFactory::createOrGetVMapManager();
         if (vmgr->isHeightCalcEnabled())
-            vmapHeight = vmgr->getHeight(GetId(), x, y, z + 2.0f, maxSearchDist);   // look from a bit higher pos to find the floor
+        {
+            // look from a bit higher pos to find the floor
+            if (m_parentMap->_floorHeightCache.Get(x, y, z + 2.0f, maxSearchDist, VMAP_INVALID_HEIGHT_VALUE, vmapHeight))
+                TC_METRIC_COUNTER("floor_height_cache_hits", 1);
+            else
+            {
+                vmapHeight = vmgr->getHeight(GetId(), x, y, z + 2.0f, maxSearchDist);
+                m_parentMap->_floorHeightCache.Store(x, y, z + 2.0f, maxSearchDist, VMAP_INVALID_HEIGHT_VALUE, vmapHeight);
+            }
+        }
     }
 
     // mapHeight set for any above raw ground Z or <= INVALID_HEIGHT
@@ -2599,8 +2696,54 @@ float Map::GetWaterLevel(float x, float y) const
 
 bool Map::isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask) const
 {
-    return VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), x1, y1, z1, x2, y2, z2)
-        && _dynamicTree.isInLineOfSight(x1, y1, z1, x2, y2, z2, phasemask);
+    LineOfSightCache& lineOfSightCache = m_parentMap->_lineOfSightCache;
+    bool staticResult;
+    if (lineOfSightCache.Get(x1, y1, z1, x2, y2, z2, staticResult))
+        TC_METRIC_COUNTER("los_cache_hits", 1);
+    else
+    {
+        staticResult = VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), x1, y1, z1, x2, y2, z2);
+        lineOfSightCache.Store(x1, y1, z1, x2, y2, z2, staticResult);
+    }
+
+    return staticResult && _dynamicTree.isInLineOfSight(x1, y1, z1, x2, y2, z2, phasemask);
+}
+
+void Map::isInLineOfSight(float x, float y, float z, std::vector<G3D::Vector3> const& targets, std::vector<bool>& results, uint32 phasemask) const
+{
+    LineOfSightCache& lineOfSightCache = m_parentMap->_lineOfSightCache;
+    results.assign(targets.size(), true);
+
+    std::vector<std::size_t> uncached;
+    std::vector<G3D::Vector3> uncachedTargets;
+    for (std::size_t i = 0; i < targets.size(); ++i)
+    {
+        bool staticResult;
+        if (lineOfSightCache.Get(x, y, z, targets[i].x, targets[i].y, targets[i].z, staticResult))
+        {
+            TC_METRIC_COUNTER("los_cache_hits", 1);
+            results[i] = staticResult;
+            continue;
+        }
+
+        uncached.push_back(i);
+        uncachedTargets.push_back(targets[i]);
+    }
+
+    if (!uncachedTargets.empty())
+    {
+        std::vector<bool> staticResults;
+        VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), x, y, z, uncachedTargets, staticResults);
+        for (std::size_t i = 0; i < uncached.size(); ++i)
+        {
+            lineOfSightCache.Store(x, y, z, uncachedTargets[i].x, uncachedTargets[i].y, uncachedTargets[i].z, staticResults[i]);
+            results[uncached[i]] = staticResults[i];
+        }
+    }
+
+    for (std::size_t i = 0; i < targets.size(); ++i)
+        if (results[i])
+            results[i] = _dynamicTree.isInLineOfSight(x, y, z, targets[i].x, targets[i].y, targets[i].z, phasemask);
 }
 
 bool Map::getObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float& ry, float& rz, float modifyDist)
@@ -30,6 +30,8 @@
 #include "MapRefManager.h"
 #include "DynamicTree.h"
 #include "GameObjectModel.h"
+#include "FloorHeightCache.h"
+#include "LineOfSightCache.h"
 #include "ObjectGuid.h"
 
 #include <bitset>
@@ -156,33 +158,36 @@ struct LiquidData
     float  depth_level;
 };
 
+class DBFileMapping;
+class GridMapFile;
+
 class TC_GAME_API GridMap
 {
     uint32  _flags;
     union{
-        float* m_V9;
-        uint16* m_uint16_V9;
-        uint8* m_uint8_V9;
+        float const* m_V9;
+        uint16 const* m_uint16_V9;
+        uint8 const* m_uint8_V9;
     };
     union{
-        float* m_V8;
-        uint16* m_uint16_V8;
-        uint8* m_uint8_V8;
+        float const* m_V8;
+        uint16 const* m_uint16_V8;
+        uint8 const* m_uint8_V8;
     };
-    int16* _maxHeight;
-    int16* _minHeight;
+    int16 const* _maxHeight;
+    int16 const* _minHeight;
     // Height level data
     float _gridHeight;
     float _gridIntHeightMultiplier;
 
     // Area data
-    uint16* _areaMap;
+    uint16 const* _areaMap;
 
     // Liquid data
     float _liquidLevel;
-    uint16* _liquidEntry;
-    uint8* _liquidFlags;
-    float* _liquidMap;
+    uint16 const* _liquidEntry;
+    uint8 const* _liquidFlags;
+    float const* _liquidMap;
     uint16 _gridArea;
     uint16 _liquidType;
     uint8 _liquidOffX;
@@ -190,10 +195,14 @@ class TC_GAME_API GridMap
     uint8 _liquidWidth;
     uint8 _liquidHeight;
 
+    // the arrays above point into it when the file is memory mapped, pages are shared with other processes mapping the same file
+    std::unique_ptr<DBFileMapping> _mapping;
 
-    bool loadAreaData(FILE* in, uint32 offset, uint32 size);
-    bool loadHeightData(FILE* in, uint32 offset, uint32 size);
-    bool loadLiquidData(FILE* in, uint32 offset, uint32 size);
+    bool loadAreaData(GridMapFile& in, uint32 offset, uint32 size);
+    bool loadHeightData(GridMapFile& in, uint32 offset, uint32 size);
+    bool loadLiquidData(GridMapFile& in, uint32 offset, uint32 size);
+    template<class T>
+    void releaseArray(T const*& data);
 
     // Get height functions and pointers
     typedef float (GridMap::*GetHeightPtr) (float x, float y) const;
@@ -209,6 +218,10 @@ public:
     bool loadData(const char* filename);
     void unloadData();
 
+    /// Map files loaded after enabling are read from a read only memory mapping instead of being copied
+    static void SetMemoryMapped(bool enable);
+    static bool IsMemoryMapped();
+
     uint16 getArea(float x, float y) const;
     inline float getHeight(float x, float y) const {return (this->*_gridGetHeight)(x, y);}
     float getMinHeight(float x, float y) const;
@@ -502,6 +515,8 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         float GetWaterOrGroundLevel(float x, float y, float z, float* ground = NULL, bool swim = false) const;
         float GetHeight(uint32 phasemask, float x, float y, float z, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
         bool isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask) const;
+        /// Line of sight from one position to each of targets, results[i] is set for targets[i]
+        void isInLineOfSight(float x, float y, float z, std::vector<G3D::Vector3> const& targets, std::vector<bool>& results, uint32 phasemask) const;
         void Balance() { _dynamicTree.balance(); }
         void RemoveGameObjectModel(const GameObjectModel& model) { _dynamicTree.remove(model); }
         void InsertGameObjectModel(const GameObjectModel& model) { _dynamicTree.insert(model); }
@@ -644,6 +659,8 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         uint32 m_unloadTimer;
         float m_VisibleDistance;
         DynamicMapTree _dynamicTree;
+        mutable LineOfSightCache _lineOfSightCache;        // instances use the one of their parent, vmap tiles are loaded there
+        mutable FloorHeightCache _floorHeightCache;        // same as _lineOfSightCache
 
         MapRefManager m_mapRefManager;
         MapRefManager::iterator m_mapRefIter;
@@ -220,7 +220,7 @@ void MapManager::Update(uint32 diff)
         if (m_updater.activated())
             m_updater.schedule_update(*iter->second, uint32(i_timer.GetCurrent()));
         else
-            iter->second->Update(uint32(i_timer.GetCurrent()));
+            MapUpdater::UpdateMap(*iter->second, uint32(i_timer.GetCurrent()));
     }
     if (m_updater.activated())
         m_updater.wait();
@@ -18,7 +18,10 @@
 
 #include "MapUpdater.h"
 #include "Map.h"
+#include "Metric.h"
+#include "TickProfiler.h"
 
+#include <chrono>
 #include <mutex>
 
 
@@ -39,11 +42,21 @@ class MapUpdateRequest
 
         void call()
         {
-            m_map.Update (m_diff);
+            MapUpdater::UpdateMap(m_map, m_diff);
             m_updater.update_finished();
         }
 };
 
+void MapUpdater::UpdateMap(Map& map, uint32 diff)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    map.Update(diff);
+
+    uint64 micros = uint64(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+    TC_METRIC_HISTOGRAM("map_update_time_us", micros);
+    sTickProfiler->RecordMapUpdate(map.GetId(), map.GetInstanceId(), micros);
+}
+
 void MapUpdater::activate(size_t num_threads)
 {
     for (size_t i = 0; i < num_threads; ++i)
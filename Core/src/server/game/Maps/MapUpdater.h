@@ -47,6 +47,9 @@ class TC_GAME_API MapUpdater
 
         bool activated();
 
+        /// Updates the map on the calling thread and records the update time
+        static void UpdateMap(Map& map, uint32 diff);
+
     private:
 
         ProducerConsumerQueue<MapUpdateRequest*> _queue;
@@ -34,7 +34,15 @@ Location MoveSpline::ComputePosition() const
         u = (time_passed - spline.length(point_Idx)) / (float)seg_time;
     Location c;
     c.orientation = initialOrientation;
-    spline.evaluate_percent(point_Idx, u, c);
+
+    // orientation follows the curve unless overridden below, evaluate both in one pass then
+    bool const orientationFromPath = !(splineflags.done && splineflags.isFacing()) &&
+        !splineflags.hasFlag(MoveSplineFlag::OrientationFixed | MoveSplineFlag::Falling | MoveSplineFlag::Unknown0);
+    Vector3 hermite;
+    if (orientationFromPath)
+        spline.evaluate_percent_and_derivative(point_Idx, u, c, hermite);
+    else
+        spline.evaluate_percent(point_Idx, u, c);
 
     if (splineflags.animation)
         ;// MoveSplineFlag::Animation disables falling or parabolic movement
@@ -53,12 +61,8 @@ Location MoveSpline::ComputePosition() const
     }
     else
     {
-        if (!splineflags.hasFlag(MoveSplineFlag::OrientationFixed | MoveSplineFlag::Falling | MoveSplineFlag::Unknown0))
-        {
-            Vector3 hermite;
-            spline.evaluate_derivative(point_Idx, u, hermite);
+        if (orientationFromPath)
             c.orientation = std::atan2(hermite.y, hermite.x);
-        }
 
         if (splineflags.orientationInversed)
             c.orientation = -c.orientation;
@@ -23,30 +23,6 @@
 
 namespace Movement{
 
-SplineBase::EvaluationMethtod SplineBase::evaluators[SplineBase::ModesEnd] =
-{
-    &SplineBase::EvaluateLinear,
-    &SplineBase::EvaluateCatmullRom,
-    &SplineBase::EvaluateBezier3,
-    (EvaluationMethtod)&SplineBase::UninitializedSpline,
-};
-
-SplineBase::EvaluationMethtod SplineBase::derivative_evaluators[SplineBase::ModesEnd] =
-{
-    &SplineBase::EvaluateDerivativeLinear,
-    &SplineBase::EvaluateDerivativeCatmullRom,
-    &SplineBase::EvaluateDerivativeBezier3,
-    (EvaluationMethtod)&SplineBase::UninitializedSpline,
-};
-
-SplineBase::SegLenghtMethtod SplineBase::seglengths[SplineBase::ModesEnd] =
-{
-    &SplineBase::SegLengthLinear,
-    &SplineBase::SegLengthCatmullRom,
-    &SplineBase::SegLengthBezier3,
-    (SegLenghtMethtod)&SplineBase::UninitializedSpline,
-};
-
 SplineBase::InitMethtod SplineBase::initializers[SplineBase::ModesEnd] =
 {
     //&SplineBase::InitLinear,
@@ -59,12 +35,6 @@ SplineBase::InitMethtod SplineBase::initializers[SplineBase::ModesEnd] =
 ///////////
 
 using G3D::Matrix4;
-static const Matrix4 s_catmullRomCoeffs(
-    -0.5f, 1.5f, -1.5f, 0.5f,
-    1.f, -2.5f, 2.f, -0.5f,
-    -0.5f, 0.f,  0.5f, 0.f,
-    0.f,  1.f,  0.f,  0.f);
-
 static const Matrix4 s_Bezier3Coeffs(
     -1.f,  3.f, -3.f, 1.f,
     3.f, -6.f,  3.f, 0.f,
@@ -113,6 +83,37 @@ inline void C_Evaluate_Derivative(const Vector3 *vertice, float t, const Matrix4
            + vertice[2] * weights[2] + vertice[3] * weights[3];
 }
 
+// Catmull-Rom basis multiplied out, (t^3, t^2, t, 1) * matrix and (3t^2, 2t, 1, 0) * matrix for the matrix
+//  -0.5   1.5  -1.5   0.5
+//   1    -2.5   2    -0.5
+//  -0.5   0     0.5   0
+//   0     1     0     0
+inline void C_CatmullRomWeights(float t, float (&w)[4])
+{
+    float t2 = t * t;
+    float t3 = t2 * t;
+    w[0] = -0.5f * t3 + t2 - 0.5f * t;
+    w[1] = 1.5f * t3 - 2.5f * t2 + 1.f;
+    w[2] = -1.5f * t3 + 2.f * t2 + 0.5f * t;
+    w[3] = 0.5f * t3 - 0.5f * t2;
+}
+
+inline void C_CatmullRomDerivativeWeights(float t, float (&w)[4])
+{
+    float t2 = t * t;
+    w[0] = -1.5f * t2 + 2.f * t - 0.5f;
+    w[1] = 4.5f * t2 - 5.f * t;
+    w[2] = -4.5f * t2 + 4.f * t + 0.5f;
+    w[3] = 1.5f * t2 - t;
+}
+
+inline void C_Apply(const Vector3 *vertice, const float (&w)[4], Vector3 &result)
+{
+    result.x = vertice[0].x * w[0] + vertice[1].x * w[1] + vertice[2].x * w[2] + vertice[3].x * w[3];
+    result.y = vertice[0].y * w[0] + vertice[1].y * w[1] + vertice[2].y * w[2] + vertice[3].y * w[3];
+    result.z = vertice[0].z * w[0] + vertice[1].z * w[1] + vertice[2].z * w[2] + vertice[3].z * w[3];
+}
+
 void SplineBase::EvaluateLinear(index_type index, float u, Vector3& result) const
 {
     ASSERT(index >= index_lo && index < index_hi);
@@ -122,7 +123,20 @@ void SplineBase::EvaluateLinear(index_type index, float u, Vector3& result) cons
 void SplineBase::EvaluateCatmullRom( index_type index, float t, Vector3& result) const
 {
     ASSERT(index >= index_lo && index < index_hi);
-    C_Evaluate(&points[index - 1], t, s_catmullRomCoeffs, result);
+    float w[4];
+    C_CatmullRomWeights(t, w);
+    C_Apply(&points[index - 1], w, result);
+}
+
+void SplineBase::EvaluateWithDerivativeCatmullRom(index_type index, float t, Vector3& result, Vector3& derivative) const
+{
+    ASSERT(index >= index_lo && index < index_hi);
+    const Vector3* p = &points[index - 1];
+    float w[4];
+    C_CatmullRomWeights(t, w);
+    C_Apply(p, w, result);
+    C_CatmullRomDerivativeWeights(t, w);
+    C_Apply(p, w, derivative);
 }
 
 void SplineBase::EvaluateBezier3(index_type index, float t, Vector3& result) const
@@ -141,7 +155,9 @@ void SplineBase::EvaluateDerivativeLinear(index_type index, float, Vector3& resu
 void SplineBase::EvaluateDerivativeCatmullRom(index_type index, float t, Vector3& result) const
 {
     ASSERT(index >= index_lo && index < index_hi);
-    C_Evaluate_Derivative(&points[index - 1], t, s_catmullRomCoeffs, result);
+    float w[4];
+    C_CatmullRomDerivativeWeights(t, w);
+    C_Apply(&points[index - 1], w, result);
 }
 
 void SplineBase::EvaluateDerivativeBezier3(index_type index, float t, Vector3& result) const
@@ -167,9 +183,11 @@ float SplineBase::SegLengthCatmullRom(index_type index) const
 
     index_type i = 1;
     float length = 0;
+    float w[4];
     while (i <= STEPS_PER_SEGMENT)
     {
-        C_Evaluate(p, float(i) / float(STEPS_PER_SEGMENT), s_catmullRomCoeffs, nextPos);
+        C_CatmullRomWeights(float(i) / float(STEPS_PER_SEGMENT), w);
+        C_Apply(p, w, nextPos);
         length += (nextPos - curPos).length();
         curPos = nextPos;
         ++i;
@@ -62,19 +62,16 @@ protected:
     void EvaluateLinear(index_type, float, Vector3&) const;
     void EvaluateCatmullRom(index_type, float, Vector3&) const;
     void EvaluateBezier3(index_type, float, Vector3&) const;
-    typedef void (SplineBase::*EvaluationMethtod)(index_type, float, Vector3&) const;
-    static EvaluationMethtod evaluators[ModesEnd];
 
     void EvaluateDerivativeLinear(index_type, float, Vector3&) const;
     void EvaluateDerivativeCatmullRom(index_type, float, Vector3&) const;
     void EvaluateDerivativeBezier3(index_type, float, Vector3&) const;
-    static EvaluationMethtod derivative_evaluators[ModesEnd];
+
+    void EvaluateWithDerivativeCatmullRom(index_type, float, Vector3&, Vector3&) const;
 
     float SegLengthLinear(index_type) const;
     float SegLengthCatmullRom(index_type) const;
     float SegLengthBezier3(index_type) const;
-    typedef float (SplineBase::*SegLenghtMethtod)(index_type) const;
-    static SegLenghtMethtod seglengths[ModesEnd];
 
     void InitLinear(const Vector3*, index_type, index_type);
     void InitCatmullRom(const Vector3*, index_type, index_type);
@@ -92,13 +89,43 @@ public:
         @param t - percent of segment length, assumes that t in range [0, 1]
         @param Idx - spline segment index, should be in range [first, last)
      */
-    void evaluate_percent(index_type Idx, float u, Vector3& c) const {(this->*evaluators[m_mode])(Idx, u, c);}
+    void evaluate_percent(index_type Idx, float u, Vector3& c) const
+    {
+        switch (m_mode)
+        {
+            case ModeLinear: EvaluateLinear(Idx, u, c); break;
+            case ModeCatmullrom: EvaluateCatmullRom(Idx, u, c); break;
+            case ModeBezier3_Unused: EvaluateBezier3(Idx, u, c); break;
+            default: UninitializedSpline(); break;
+        }
+    }
 
     /** Caclulates derivation in index Idx, and percent of segment length t
         @param Idx - spline segment index, should be in range [first, last)
         @param t  - percent of spline segment length, assumes that t in range [0, 1]
      */
-    void evaluate_derivative(index_type Idx, float u, Vector3& hermite) const {(this->*derivative_evaluators[m_mode])(Idx, u, hermite);}
+    void evaluate_derivative(index_type Idx, float u, Vector3& hermite) const
+    {
+        switch (m_mode)
+        {
+            case ModeLinear: EvaluateDerivativeLinear(Idx, u, hermite); break;
+            case ModeCatmullrom: EvaluateDerivativeCatmullRom(Idx, u, hermite); break;
+            case ModeBezier3_Unused: EvaluateDerivativeBezier3(Idx, u, hermite); break;
+            default: UninitializedSpline(); break;
+        }
+    }
+
+    /** Same as evaluate_percent followed by evaluate_derivative, control points are read only once */
+    void evaluate_percent_and_derivative(index_type Idx, float u, Vector3& c, Vector3& hermite) const
+    {
+        switch (m_mode)
+        {
+            case ModeLinear: EvaluateLinear(Idx, u, c); EvaluateDerivativeLinear(Idx, u, hermite); break;
+            case ModeCatmullrom: EvaluateWithDerivativeCatmullRom(Idx, u, c, hermite); break;
+            case ModeBezier3_Unused: EvaluateBezier3(Idx, u, c); EvaluateDerivativeBezier3(Idx, u, hermite); break;
+            default: UninitializedSpline(); break;
+        }
+    }
 
     /**  Bounds for spline indexes. All indexes should be in range [first, last). */
     index_type first() const { return index_lo;}
@@ -126,7 +153,16 @@ public:
     void clear();
 
     /** Calculates distance between [i; i+1] points, assumes that index i is in bounds. */
-    float SegLength(index_type i) const { return (this->*seglengths[m_mode])(i);}
+    float SegLength(index_type i) const
+    {
+        switch (m_mode)
+        {
+            case ModeLinear: return SegLengthLinear(i);
+            case ModeCatmullrom: return SegLengthCatmullRom(i);
+            case ModeBezier3_Unused: return SegLengthBezier3(i);
+            default: UninitializedSpline(); return 0.f;
+        }
+    }
 
     std::string ToString() const;
 };
@@ -164,6 +200,8 @@ public:
         @param t  - percent of spline segment length, assumes that t in range [0, 1]. */
     void evaluate_derivative(index_type Idx, float u, Vector3& c) const { SplineBase::evaluate_derivative(Idx, u, c);}
 
+    void evaluate_percent_and_derivative(index_type Idx, float u, Vector3& c, Vector3& hermite) const { SplineBase::evaluate_percent_and_derivative(Idx, u, c, hermite);}
+
     // Assumes that t in range [0, 1]
     index_type computeIndexInBounds(float t) const;
     void computeIndex(float t, index_type& out_idx, float& out_u) const;
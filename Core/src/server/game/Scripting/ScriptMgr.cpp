@@ -1245,6 +1245,11 @@ void ScriptMgr::OnPacketReceive(WorldSession* session, WorldPacket const& packet
     FOREACH_SCRIPT(ServerScript)->OnPacketReceive(session, copy);
 }
 
+bool ScriptMgr::HasPacketHooks() const
+{
+    return !SCR_REG_LST(ServerScript).empty();
+}
+
 void ScriptMgr::OnPacketSend(WorldSession* session, WorldPacket const& packet)
 {
     ASSERT(session);
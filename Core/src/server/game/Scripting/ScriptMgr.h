@@ -901,6 +901,8 @@ class TC_GAME_API ScriptMgr
         void OnSocketOpen(std::shared_ptr<WorldSocket> socket);
         void OnSocketClose(std::shared_ptr<WorldSocket> socket);
         void OnPacketReceive(WorldSession* session, WorldPacket const& packet);
+        /// Whether any server script may see received packets
+        bool HasPacketHooks() const;
         void OnPacketSend(WorldSession* session, WorldPacket const& packet);
 
     public: /* WorldScript */
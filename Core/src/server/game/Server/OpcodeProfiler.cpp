@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2008-2016 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "OpcodeProfiler.h"
+#include "Metric.h"
+#include <algorithm>
+
+OpcodeProfiler::Stats::Stats() : Count(0), Bytes(0), TotalMicros(0), MaxMicros(0), ExportedCount(0), ExportedMicros(0)
+{
+    for (std::atomic<uint64>& bucket : Histogram)
+        bucket.store(0, std::memory_order_relaxed);
+}
+
+void OpcodeProfiler::Stats::Clear()
+{
+    Count.store(0, std::memory_order_relaxed);
+    Bytes.store(0, std::memory_order_relaxed);
+    TotalMicros.store(0, std::memory_order_relaxed);
+    MaxMicros.store(0, std::memory_order_relaxed);
+    for (std::atomic<uint64>& bucket : Histogram)
+        bucket.store(0, std::memory_order_relaxed);
+
+    ExportedCount = 0;
+    ExportedMicros = 0;
+}
+
+OpcodeProfiler::OpcodeProfiler()
+{
+    for (std::atomic<Stats*>& stats : _stats)
+        stats.store(nullptr, std::memory_order_relaxed);
+}
+
+OpcodeProfiler::~OpcodeProfiler()
+{
+    for (std::atomic<Stats*>& stats : _stats)
+        delete stats.load(std::memory_order_relaxed);
+}
+
+OpcodeProfiler* OpcodeProfiler::instance()
+{
+    static OpcodeProfiler instance;
+    return &instance;
+}
+
+char const* OpcodeProfiler::GetProcessingPlaceName(PacketProcessing processingPlace)
+{
+    switch (processingPlace)
+    {
+        case PROCESS_THREADSAFE:
+            return "map";
+        case PROCESS_SESSION_LOCAL:
+            return "session";
+        default:
+            return "world";
+    }
+}
+
+uint32 OpcodeProfiler::GetIndex(uint16 opcode, PacketProcessing processingPlace)
+{
+    uint32 place = 0;
+    if (processingPlace == PROCESS_THREADSAFE)
+        place = 1;
+    else if (processingPlace == PROCESS_SESSION_LOCAL)
+        place = 2;
+
+    return uint32(opcode) * ProcessingPlaceCount + place;
+}
+
+PacketProcessing OpcodeProfiler::GetProcessingPlace(uint32 index)
+{
+    switch (index % ProcessingPlaceCount)
+    {
+        case 1:
+            return PROCESS_THREADSAFE;
+        case 2:
+            return PROCESS_SESSION_LOCAL;
+        default:
+            return PROCESS_THREADUNSAFE;
+    }
+}
+
+void OpcodeProfiler::AddSample(uint16 opcode, PacketProcessing processingPlace, std::size_t bytes, uint64 micros)
+{
+    if (opcode >= NUM_OPCODE_HANDLERS)
+        return;
+
+    std::atomic<Stats*>& slot = _stats[GetIndex(opcode, processingPlace)];
+    Stats* stats = slot.load(std::memory_order_acquire);
+    if (!stats)
+    {
+        Stats* newStats = new Stats();
+        if (slot.compare_exchange_strong(stats, newStats, std::memory_order_acq_rel))
+            stats = newStats;
+        else
+            delete newStats;                            // another thread was faster, stats now holds its pointer
+    }
+
+    stats->Count.fetch_add(1, std::memory_order_relaxed);
+    stats->Bytes.fetch_add(bytes, std::memory_order_relaxed);
+    stats->TotalMicros.fetch_add(micros, std::memory_order_relaxed);
+
+    uint64 max = stats->MaxMicros.load(std::memory_order_relaxed);
+    while (micros > max && !stats->MaxMicros.compare_exchange_weak(max, micros, std::memory_order_relaxed))
+        ;
+
+    uint32 bucket = 0;
+    while (bucket + 1 < HistogramBuckets && (uint64(1) << (bucket + 1)) <= micros)
+        ++bucket;
+
+    stats->Histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+std::vector<OpcodeProfiler::Entry> OpcodeProfiler::GetTopEntries(uint32 limit) const
+{
+    std::vector<Entry> entries;
+    for (uint32 index = 0; index < _stats.size(); ++index)
+    {
+        Stats const* stats = _stats[index].load(std::memory_order_acquire);
+        if (!stats)
+            continue;
+
+        Entry entry;
+        entry.Opcode = uint16(index / ProcessingPlaceCount);
+        entry.ProcessingPlace = GetProcessingPlace(index);
+        entry.Count = stats->Count.load(std::memory_order_relaxed);
+        if (!entry.Count)
+            continue;
+
+        entry.Bytes = stats->Bytes.load(std::memory_order_relaxed);
+        entry.TotalMicros = stats->TotalMicros.load(std::memory_order_relaxed);
+        entry.MaxMicros = stats->MaxMicros.load(std::memory_order_relaxed);
+
+        std::array<uint64, HistogramBuckets> histogram;
+        uint64 samples = 0;
+        for (uint32 bucket = 0; bucket < HistogramBuckets; ++bucket)
+            samples += histogram[bucket] = stats->Histogram[bucket].load(std::memory_order_relaxed);
+
+        entry.Percentile50 = 0;
+        entry.Percentile99 = 0;
+        uint64 seen = 0;
+        for (uint32 bucket = 0; bucket < HistogramBuckets; ++bucket)
+        {
+            seen += histogram[bucket];
+            if (!entry.Percentile50 && seen * 2 >= samples)
+                entry.Percentile50 = uint64(1) << (bucket + 1);
+            if (!entry.Percentile99 && seen * 100 >= samples * 99)
+                entry.Percentile99 = uint64(1) << (bucket + 1);
+        }
+
+        entries.push_back(entry);
+    }
+
+    std::sort(entries.begin(), entries.end(), [](Entry const& left, Entry const& right)
+    {
+        return left.TotalMicros > right.TotalMicros;
+    });
+
+    if (entries.size() > limit)
+        entries.resize(limit);
+
+    return entries;
+}
+
+void OpcodeProfiler::Reset()
+{
+    for (std::atomic<Stats*>& slot : _stats)
+        if (Stats* stats = slot.load(std::memory_order_acquire))
+            stats->Clear();
+}
+
+void OpcodeProfiler::LogMetrics()
+{
+    if (!sMetric->IsEnabled())
+        return;
+
+    for (uint32 index = 0; index < _stats.size(); ++index)
+    {
+        Stats* stats = _stats[index].load(std::memory_order_acquire);
+        if (!stats)
+            continue;
+
+        uint64 count = stats->Count.load(std::memory_order_relaxed);
+        uint64 micros = stats->TotalMicros.load(std::memory_order_relaxed);
+        if (count <= stats->ExportedCount)
+        {
+            // nothing new, or the counters were reset
+            stats->ExportedCount = count;
+            stats->ExportedMicros = micros;
+            continue;
+        }
+
+        std::string name = GetOpcodeNameForLogging(static_cast<OpcodeClient>(index / ProcessingPlaceCount));
+        char const* place = GetProcessingPlaceName(GetProcessingPlace(index));
+        TC_METRIC_VALUE("opcode_calls_" + name + "_" + place, count - stats->ExportedCount);
+        TC_METRIC_VALUE("opcode_time_" + name + "_" + place, micros - std::min(micros, stats->ExportedMicros));
+
+        stats->ExportedCount = count;
+        stats->ExportedMicros = micros;
+    }
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2008-2016 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OpcodeProfiler_h__
+#define OpcodeProfiler_h__
+
+#include "Define.h"
+#include "Opcodes.h"
+#include <array>
+#include <atomic>
+#include <vector>
+
+/// Handler time, calls and bytes per client opcode, split by processing place (map, session updater or world thread)
+class TC_GAME_API OpcodeProfiler
+{
+    public:
+        static uint32 const HistogramBuckets = 16;     // log2 of microseconds, the last one is everything above 16 ms
+
+        struct Entry
+        {
+            uint16 Opcode;
+            PacketProcessing ProcessingPlace;
+            uint64 Count;
+            uint64 Bytes;
+            uint64 TotalMicros;
+            uint64 MaxMicros;
+            uint64 Percentile50;                        // upper bound of the histogram bucket, in microseconds
+            uint64 Percentile99;
+        };
+
+        static OpcodeProfiler* instance();
+
+        /// "map", "session" or "world"
+        static char const* GetProcessingPlaceName(PacketProcessing processingPlace);
+
+        void AddSample(uint16 opcode, PacketProcessing processingPlace, std::size_t bytes, uint64 micros);
+
+        /// Opcodes sorted by total handler time
+        std::vector<Entry> GetTopEntries(uint32 limit) const;
+        void Reset();
+
+        /// Sends the calls and handler time of opcodes used since the last call to the metric database
+        void LogMetrics();
+
+    private:
+        OpcodeProfiler();
+        ~OpcodeProfiler();
+
+        struct Stats
+        {
+            std::atomic<uint64> Count;
+            std::atomic<uint64> Bytes;
+            std::atomic<uint64> TotalMicros;
+            std::atomic<uint64> MaxMicros;
+            std::array<std::atomic<uint64>, HistogramBuckets> Histogram;
+
+            // only touched by LogMetrics
+            uint64 ExportedCount;
+            uint64 ExportedMicros;
+
+            Stats();
+            void Clear();
+        };
+
+        // world (in place and thread unsafe), map and session local handlers are counted separately
+        static uint32 const ProcessingPlaceCount = 3;
+
+        static uint32 GetIndex(uint16 opcode, PacketProcessing processingPlace);
+        static PacketProcessing GetProcessingPlace(uint32 index);
+
+        // allocated on first use, most opcodes are never received
+        std::array<std::atomic<Stats*>, NUM_OPCODE_HANDLERS * ProcessingPlaceCount> _stats;
+};
+
+#define sOpcodeProfiler OpcodeProfiler::instance()
+
+#endif // OpcodeProfiler_h__
@@ -1688,7 +1688,8 @@ enum PacketProcessing
 {
     PROCESS_INPLACE = 0,                                    //process packet whenever we receive it - mostly for non-handled or non-implemented packets
     PROCESS_THREADUNSAFE,                                   //packet is not thread-safe - process it in World::UpdateSessions()
-    PROCESS_THREADSAFE                                      //packet is thread-safe - process it in Map::Update()
+    PROCESS_THREADSAFE,                                     //packet is thread-safe - process it in Map::Update()
+    PROCESS_SESSION_LOCAL                                   //packet only touches the session and its player - process it in parallel in World::UpdateSessions()
 };
 
 class WorldPacket;
@@ -22,6 +22,7 @@
 #include "Common.h"
 #include "Opcodes.h"
 #include "ByteBuffer.h"
+#include "BufferPool.h"
 
 class WorldPacket : public ByteBuffer
 {
@@ -81,6 +82,10 @@ class WorldPacket : public ByteBuffer
 
         ConnectionType GetConnection() const { return _connection; }
 
+        // packets queued between network and session threads are recycled instead of going back to the heap
+        static void* operator new(size_t size) { return BufferPool::AllocateBlock(size); }
+        static void operator delete(void* block, size_t size) { BufferPool::FreeBlock(block, size); }
+
     protected:
         uint32 m_opcode;
         ConnectionType _connection;
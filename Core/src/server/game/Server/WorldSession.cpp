@@ -53,6 +53,7 @@
 #include "PacketUtilities.h"
 #include "CollectionMgr.h"
 #include "Metric.h"
+#include "OpcodeProfiler.h"
 
 #include <zlib.h>
 
@@ -71,7 +72,7 @@ bool MapSessionFilter::Process(WorldPacket* packet)
         return true;
 
     //we do not process thread-unsafe packets
-    if (opHandle->ProcessingPlace == PROCESS_THREADUNSAFE)
+    if (opHandle->ProcessingPlace == PROCESS_THREADUNSAFE || opHandle->ProcessingPlace == PROCESS_SESSION_LOCAL)
         return false;
 
     Player* player = m_pSession->GetPlayer();
@@ -93,7 +94,7 @@ bool WorldSessionFilter::Process(WorldPacket* packet)
         return true;
 
     //thread-unsafe packets should be processed in World::UpdateSessions()
-    if (opHandle->ProcessingPlace == PROCESS_THREADUNSAFE)
+    if (opHandle->ProcessingPlace == PROCESS_THREADUNSAFE || opHandle->ProcessingPlace == PROCESS_SESSION_LOCAL)
         return true;
 
     //no player attached? -> our client! ^^
@@ -105,6 +106,15 @@ bool WorldSessionFilter::Process(WorldPacket* packet)
     return (player->IsInWorld() == false);
 }
 
+//only packets that touch nothing but the session, its player and read-only global data
+//packet hooks of server scripts expect the world thread, with any loaded all packets stay there
+bool SessionLocalFilter::Process(WorldPacket* packet)
+{
+    ClientOpcodeHandler const* opHandle = opcodeTable[static_cast<OpcodeClient>(packet->GetOpcode())];
+
+    return opHandle->ProcessingPlace == PROCESS_SESSION_LOCAL && !sScriptMgr->HasPacketHooks();
+}
+
 /// WorldSession constructor
 WorldSession::WorldSession(uint32 id, std::string&& name, uint32 battlenetAccountId, std::shared_ptr<WorldSocket> sock, AccountTypes sec, uint8 expansion, time_t mute_time,
     std::string os, LocaleConstant locale, uint32 recruiter, bool isARecruiter):
@@ -139,7 +149,10 @@ WorldSession::WorldSession(uint32 id, std::string&& name, uint32 battlenetAccoun
     forceExit(false),
     m_currentBankerGUID(),
     _battlePetMgr(Trinity::make_unique<BattlePetMgr>(this)),
-    _collectionMgr(Trinity::make_unique<CollectionMgr>(this))
+    _collectionMgr(Trinity::make_unique<CollectionMgr>(this)),
+    _handlerCostWindow(0),
+    _handlerCostMicros(0),
+    _handlerBudgetExceeded(false)
 {
     memset(_tutorials, 0, sizeof(_tutorials));
 
@@ -299,6 +312,8 @@ void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/
     sScriptMgr->OnPacketSend(this, *packet);
 
     TC_LOG_TRACE("network.opcode", "S->C: %s %s", GetPlayerInfo().c_str(), GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet->GetOpcode())).c_str());
+    TC_METRIC_COUNTER("world_packets_sent", 1);
+    TC_METRIC_COUNTER("world_packets_sent_bytes", packet->size());
     m_Socket[conIdx]->SendPacket(*packet);
 }
 
@@ -308,6 +323,58 @@ void WorldSession::QueuePacket(WorldPacket* new_packet)
     _recvQueue.add(new_packet);
 }
 
+void WorldSession::CallOpcodeHandler(ClientOpcodeHandler const* opHandle, WorldPacket& packet)
+{
+    bool profile = sWorld->getBoolConfig(CONFIG_OPCODE_PROFILER_ENABLED);
+    bool budget = sWorld->getIntConfig(CONFIG_OPCODE_PROFILER_SESSION_BUDGET) != 0;
+    if (!profile && !budget)
+    {
+        opHandle->Call(this, packet);
+        return;
+    }
+
+    // read before the call, handlers may move the packet contents
+    uint16 opcode = uint16(packet.GetOpcode());
+    std::size_t size = packet.size();
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    opHandle->Call(this, packet);
+    uint64 micros = uint64(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+
+    if (profile)
+        sOpcodeProfiler->AddSample(opcode, opHandle->ProcessingPlace, size, micros);
+
+    _handlerCostMicros += micros;
+}
+
+bool WorldSession::IsHandlerBudgetExceeded(time_t currentTime)
+{
+    uint32 budget = sWorld->getIntConfig(CONFIG_OPCODE_PROFILER_SESSION_BUDGET);
+    if (!budget)
+        return false;
+
+    if (_handlerCostWindow != currentTime)
+    {
+        _handlerCostWindow = currentTime;
+        _handlerCostMicros = 0;
+        _handlerBudgetExceeded = false;
+    }
+
+    if (_handlerCostMicros < budget)
+        return false;
+
+    // leave the remaining packets queued until the next second
+    if (!_handlerBudgetExceeded)
+    {
+        _handlerBudgetExceeded = true;
+        TC_LOG_WARN("network", "WorldSession::Update: %s used " UI64FMTD " us of packet handler time this second (budget %u us), throttling",
+            GetPlayerInfo().c_str(), _handlerCostMicros, budget);
+        TC_METRIC_EVENT("events", "Session throttled", GetPlayerInfo());
+    }
+
+    return true;
+}
+
 /// Logging helper for unexpected opcodes
 void WorldSession::LogUnexpectedOpcode(WorldPacket* packet, const char* status, const char *reason)
 {
@@ -337,7 +404,55 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
     if (IsConnectionIdle())
         m_Socket[CONNECTION_TYPE_REALM]->CloseSocket();
 
-    ///- Retrieve packets from the receive queue and call the appropriate handlers
+    ProcessPackets(updater);
+
+    if (m_Socket[CONNECTION_TYPE_REALM] && m_Socket[CONNECTION_TYPE_REALM]->IsOpen() && _warden)
+        _warden->Update();
+
+    ProcessQueryCallbacks();
+
+    //check if we are safe to proceed with logout
+    //logout procedure should happen only in World::UpdateSessions() method!!!
+    if (updater.ProcessUnsafe())
+    {
+        time_t currTime = time(NULL);
+        ///- If necessary, log the player out
+        if (ShouldLogOut(currTime) && m_playerLoading.IsEmpty())
+            LogoutPlayer(true);
+
+        if (m_Socket[CONNECTION_TYPE_REALM] && GetPlayer() && _warden)
+            _warden->Update();
+
+        ///- Cleanup socket pointer if need
+        if ((m_Socket[CONNECTION_TYPE_REALM] && !m_Socket[CONNECTION_TYPE_REALM]->IsOpen()) ||
+            (m_Socket[CONNECTION_TYPE_INSTANCE] && !m_Socket[CONNECTION_TYPE_INSTANCE]->IsOpen()))
+        {
+            expireTime -= expireTime > diff ? diff : expireTime;
+            if (expireTime < diff || forceExit || !GetPlayer())
+            {
+                if (m_Socket[CONNECTION_TYPE_REALM])
+                {
+                    m_Socket[CONNECTION_TYPE_REALM]->CloseSocket();
+                    m_Socket[CONNECTION_TYPE_REALM].reset();
+                }
+                if (m_Socket[CONNECTION_TYPE_INSTANCE])
+                {
+                    m_Socket[CONNECTION_TYPE_INSTANCE]->CloseSocket();
+                    m_Socket[CONNECTION_TYPE_INSTANCE].reset();
+                }
+            }
+        }
+
+        if (!m_Socket[CONNECTION_TYPE_REALM])
+            return false;                                       //Will remove this session from the world session map
+    }
+
+    return true;
+}
+
+/// Retrieve packets accepted by the filter from the receive queue and call the appropriate handlers
+void WorldSession::ProcessPackets(PacketFilter& updater)
+{
     /// not process packets if socket already closed
     WorldPacket* packet = NULL;
     //! Delete packet after processing by default
@@ -346,7 +461,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
     uint32 processedPackets = 0;
     time_t currentTime = time(NULL);
 
-    while (m_Socket[CONNECTION_TYPE_REALM] && _recvQueue.next(packet, updater))
+    while (m_Socket[CONNECTION_TYPE_REALM] && !IsHandlerBudgetExceeded(currentTime) && _recvQueue.next(packet, updater))
     {
         ClientOpcodeHandler const* opHandle = opcodeTable[static_cast<OpcodeClient>(packet->GetOpcode())];
         try
@@ -370,7 +485,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
                     else if (_player->IsInWorld() && AntiDOS.EvaluateOpcode(*packet, currentTime))
                     {
                         sScriptMgr->OnPacketReceive(this, *packet);
-                        opHandle->Call(this, *packet);
+                        CallOpcodeHandler(opHandle, *packet);
                         LogUnprocessedTail(packet);
                     }
                     // lag can cause STATUS_LOGGEDIN opcodes to arrive after the player started a transfer
@@ -383,7 +498,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
                     {
                         // not expected _player or must checked in packet hanlder
                         sScriptMgr->OnPacketReceive(this, *packet);
-                        opHandle->Call(this, *packet);
+                        CallOpcodeHandler(opHandle, *packet);
                         LogUnprocessedTail(packet);
                     }
                     break;
@@ -395,7 +510,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
                     else if (AntiDOS.EvaluateOpcode(*packet, currentTime))
                     {
                         sScriptMgr->OnPacketReceive(this, *packet);
-                        opHandle->Call(this, *packet);
+                        CallOpcodeHandler(opHandle, *packet);
                         LogUnprocessedTail(packet);
                     }
                     break;
@@ -415,7 +530,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
                     if (AntiDOS.EvaluateOpcode(*packet, currentTime))
                     {
                         sScriptMgr->OnPacketReceive(this, *packet);
-                        opHandle->Call(this, *packet);
+                        CallOpcodeHandler(opHandle, *packet);
                         LogUnprocessedTail(packet);
                     }
                     break;
@@ -458,49 +573,6 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
     TC_METRIC_VALUE("processed_packets", processedPackets);
 
     _recvQueue.readd(requeuePackets.begin(), requeuePackets.end());
-
-    if (m_Socket[CONNECTION_TYPE_REALM] && m_Socket[CONNECTION_TYPE_REALM]->IsOpen() && _warden)
-        _warden->Update();
-
-    ProcessQueryCallbacks();
-
-    //check if we are safe to proceed with logout
-    //logout procedure should happen only in World::UpdateSessions() method!!!
-    if (updater.ProcessUnsafe())
-    {
-        time_t currTime = time(NULL);
-        ///- If necessary, log the player out
-        if (ShouldLogOut(currTime) && m_playerLoading.IsEmpty())
-            LogoutPlayer(true);
-
-        if (m_Socket[CONNECTION_TYPE_REALM] && GetPlayer() && _warden)
-            _warden->Update();
-
-        ///- Cleanup socket pointer if need
-        if ((m_Socket[CONNECTION_TYPE_REALM] && !m_Socket[CONNECTION_TYPE_REALM]->IsOpen()) ||
-            (m_Socket[CONNECTION_TYPE_INSTANCE] && !m_Socket[CONNECTION_TYPE_INSTANCE]->IsOpen()))
-        {
-            expireTime -= expireTime > diff ? diff : expireTime;
-            if (expireTime < diff || forceExit || !GetPlayer())
-            {
-                if (m_Socket[CONNECTION_TYPE_REALM])
-                {
-                    m_Socket[CONNECTION_TYPE_REALM]->CloseSocket();
-                    m_Socket[CONNECTION_TYPE_REALM].reset();
-                }
-                if (m_Socket[CONNECTION_TYPE_INSTANCE])
-                {
-                    m_Socket[CONNECTION_TYPE_INSTANCE]->CloseSocket();
-                    m_Socket[CONNECTION_TYPE_INSTANCE].reset();
-                }
-            }
-        }
-
-        if (!m_Socket[CONNECTION_TYPE_REALM])
-            return false;                                       //Will remove this session from the world session map
-    }
-
-    return true;
 }
 
 /// %Log the player out
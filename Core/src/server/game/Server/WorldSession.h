@@ -881,6 +881,17 @@ public:
     bool ProcessUnsafe() const override { return true; }
 };
 
+//class used to filter packets handled in parallel by the session workers
+//of World::UpdateSessions(), before the thread-unsafe pass
+class SessionLocalFilter : public PacketFilter
+{
+public:
+    explicit SessionLocalFilter(WorldSession* pSession) : PacketFilter(pSession) { }
+    ~SessionLocalFilter() { }
+
+    bool Process(WorldPacket* packet) override;
+};
+
 struct PacketCounter
 {
     time_t lastReceiveTime;
@@ -968,6 +979,7 @@ class TC_GAME_API WorldSession
 
         void QueuePacket(WorldPacket* new_packet);
         bool Update(uint32 diff, PacketFilter& updater);
+        void ProcessPackets(PacketFilter& updater);
 
         /// Handle the authentication waiting queue (to be completed)
         void SendAuthWaitQue(uint32 position);
@@ -1800,6 +1812,10 @@ class TC_GAME_API WorldSession
         void LogUnexpectedOpcode(WorldPacket* packet, const char* status, const char *reason);
         void LogUnprocessedTail(WorldPacket* packet);
 
+        // calls the handler, feeding OpcodeProfiler and the handler time budget of the session
+        void CallOpcodeHandler(ClientOpcodeHandler const* opHandle, WorldPacket& packet);
+        bool IsHandlerBudgetExceeded(time_t currentTime);
+
         // EnumData helpers
         bool IsLegitCharacterForAccount(ObjectGuid lowGUID)
         {
@@ -1863,6 +1879,11 @@ class TC_GAME_API WorldSession
 
         ConnectToKey _instanceConnectKey;
 
+        // packet handler time used in the current second, see OpcodeProfiler.SessionBudget
+        time_t _handlerCostWindow;
+        uint64 _handlerCostMicros;
+        bool _handlerBudgetExceeded;
+
         WorldSession(WorldSession const& right) = delete;
         WorldSession& operator=(WorldSession const& right) = delete;
 };
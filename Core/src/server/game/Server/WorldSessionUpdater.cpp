@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2008-2016 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "WorldSessionUpdater.h"
+#include "WorldSession.h"
+
+WorldSessionUpdater::~WorldSessionUpdater()
+{
+    // startup failures and early exits never reach World::StopSessionUpdater
+    if (IsActivated())
+        Deactivate();
+}
+
+void WorldSessionUpdater::Activate(std::size_t numThreads)
+{
+    for (std::size_t i = 0; i < numThreads; ++i)
+        _workerThreads.push_back(std::thread(&WorldSessionUpdater::WorkerThread, this));
+}
+
+void WorldSessionUpdater::Deactivate()
+{
+    // finish the scheduled batches before canceling, a canceled worker drops its batch
+    Wait();
+
+    _cancelationToken = true;
+
+    _queue.Cancel();
+
+    for (std::thread& thread : _workerThreads)
+        thread.join();
+
+    _workerThreads.clear();
+}
+
+void WorldSessionUpdater::Wait()
+{
+    std::unique_lock<std::mutex> lock(_lock);
+
+    while (_pendingBatches > 0)
+        _condition.wait(lock);
+}
+
+void WorldSessionUpdater::ScheduleBatch(std::vector<WorldSession*>&& sessions)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    ++_pendingBatches;
+
+    _queue.Push(new std::vector<WorldSession*>(std::move(sessions)));
+}
+
+void WorldSessionUpdater::BatchFinished()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    --_pendingBatches;
+
+    _condition.notify_all();
+}
+
+void WorldSessionUpdater::WorkerThread()
+{
+    while (1)
+    {
+        std::vector<WorldSession*>* sessions = nullptr;
+
+        _queue.WaitAndPop(sessions);
+
+        if (_cancelationToken)
+            return;
+
+        for (WorldSession* session : *sessions)
+        {
+            SessionLocalFilter filter(session);
+            session->ProcessPackets(filter);
+        }
+
+        delete sessions;
+
+        BatchFinished();
+    }
+}
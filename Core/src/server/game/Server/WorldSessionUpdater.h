@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2008-2016 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef WorldSessionUpdater_h__
+#define WorldSessionUpdater_h__
+
+#include "Define.h"
+#include "ProducerConsumerQueue.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorldSession;
+
+/// Worker threads handling the PROCESS_SESSION_LOCAL packets of batches of sessions
+class TC_GAME_API WorldSessionUpdater
+{
+    public:
+        WorldSessionUpdater() : _cancelationToken(false), _pendingBatches(0) { }
+        ~WorldSessionUpdater();
+
+        /// A batch is handled by one worker, sessions sharing per-map state must be put in the same batch
+        void ScheduleBatch(std::vector<WorldSession*>&& sessions);
+        void Wait();
+
+        void Activate(std::size_t numThreads);
+        void Deactivate();
+        bool IsActivated() const { return !_workerThreads.empty(); }
+        std::size_t GetThreadCount() const { return _workerThreads.size(); }
+
+    private:
+        void BatchFinished();
+        void WorkerThread();
+
+        ProducerConsumerQueue<std::vector<WorldSession*>*> _queue;
+
+        std::vector<std::thread> _workerThreads;
+        std::atomic<bool> _cancelationToken;
+
+        std::mutex _lock;
+        std::condition_variable _condition;
+        std::size_t _pendingBatches;
+};
+
+#endif // WorldSessionUpdater_h__
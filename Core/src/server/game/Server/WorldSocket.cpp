@@ -22,6 +22,7 @@
 #include "BigNumber.h"
 #include "CharacterPackets.h"
 #include "HmacHash.h"
+#include "Metric.h"
 #include "Opcodes.h"
 #include "PacketLog.h"
 #include "ScriptMgr.h"
@@ -30,6 +31,8 @@
 #include "World.h"
 
 #include <zlib.h>
+#include <array>
+#include <atomic>
 #include <memory>
 
 #pragma pack(push, 1)
@@ -61,6 +64,27 @@ std::string const WorldSocket::ServerConnectionInitialize("WORLD OF WARCRAFT CON
 std::string const WorldSocket::ClientConnectionInitialize("WORLD OF WARCRAFT CONNECTION - CLIENT TO SERVER", 48);
 uint32 const WorldSocket::MinSizeForCompression = 0x400;
 
+namespace
+{
+    // packets copied to the heap per opcode, received (queued to the session) and sent (queued to the socket)
+    struct PacketAllocationCounter
+    {
+        std::atomic<uint64> Count;
+        std::atomic<uint64> Bytes;
+
+        PacketAllocationCounter() : Count(0), Bytes(0) { }
+
+        void Add(std::size_t size)
+        {
+            Count.fetch_add(1, std::memory_order_relaxed);
+            Bytes.fetch_add(size, std::memory_order_relaxed);
+        }
+    };
+
+    std::array<PacketAllocationCounter, NUM_OPCODE_HANDLERS> ReceivedPacketAllocations;
+    std::array<PacketAllocationCounter, NUM_OPCODE_HANDLERS> SentPacketAllocations;
+}
+
 uint32 const SizeOfClientHeader[2] = { sizeof(uint16) + sizeof(uint16), sizeof(uint32) + sizeof(uint16) };
 uint32 const SizeOfServerHeader[2] = { sizeof(uint16) + sizeof(uint16), sizeof(uint32) + sizeof(uint16) };
 
@@ -396,6 +420,9 @@ WorldSocket::ReadDataHandlerResult WorldSocket::ReadDataHandler()
 
     WorldPacket packet(opcode, std::move(_packetBuffer), GetConnectionType());
 
+    TC_METRIC_COUNTER("world_packets_received", 1);
+    TC_METRIC_COUNTER("world_packets_received_bytes", packet.size());
+
     if (sPacketLog->CanLogPacket())
         sPacketLog->LogPacket(packet, CLIENT_TO_SERVER, GetRemoteIpAddress(), GetRemotePort(), GetConnectionType());
 
@@ -505,6 +532,7 @@ WorldSocket::ReadDataHandlerResult WorldSocket::ReadDataHandler()
             _worldSession->ResetTimeOutTime();
 
             // Copy the packet to the heap before enqueuing
+            ReceivedPacketAllocations[opcode].Add(packet.size());
             _worldSession->QueuePacket(new WorldPacket(std::move(packet)));
             break;
         }
@@ -540,9 +568,46 @@ void WorldSocket::SendPacket(WorldPacket const& packet)
     if (sPacketLog->CanLogPacket())
         sPacketLog->LogPacket(packet, SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort(), GetConnectionType());
 
+    if (packet.GetOpcode() < NUM_OPCODE_HANDLERS)
+        SentPacketAllocations[packet.GetOpcode()].Add(packet.size());
+
     _bufferQueue.Enqueue(new EncryptablePacket(packet, _authCrypt.IsInitialized()));
 }
 
+void WorldSocket::LogPacketAllocations(uint32 limit)
+{
+    if (!sLog->ShouldLog("network", LOG_LEVEL_INFO))
+        return;
+
+    auto logTop = [limit](std::array<PacketAllocationCounter, NUM_OPCODE_HANDLERS> const& counters, bool received)
+    {
+        std::vector<std::pair<uint64, uint32>> opcodes;
+        for (uint32 opcode = 0; opcode < NUM_OPCODE_HANDLERS; ++opcode)
+            if (uint64 count = counters[opcode].Count.load(std::memory_order_relaxed))
+                opcodes.emplace_back(count, opcode);
+
+        std::sort(opcodes.begin(), opcodes.end(), std::greater<std::pair<uint64, uint32>>());
+        if (opcodes.size() > limit)
+            opcodes.resize(limit);
+
+        TC_LOG_INFO("network", "WorldSocket::LogPacketAllocations: top %u %s opcodes by packet allocations", uint32(opcodes.size()), received ? "received" : "sent");
+        for (std::pair<uint64, uint32> const& itr : opcodes)
+            TC_LOG_INFO("network", "  %s: " UI64FMTD " packets, " UI64FMTD " bytes",
+                received ? GetOpcodeNameForLogging(static_cast<OpcodeClient>(itr.second)).c_str() : GetOpcodeNameForLogging(static_cast<OpcodeServer>(itr.second)).c_str(),
+                itr.first, counters[itr.second].Bytes.load(std::memory_order_relaxed));
+    };
+
+    logTop(ReceivedPacketAllocations, true);
+    logTop(SentPacketAllocations, false);
+
+    BufferPool::Statistics storage = BufferPool::GetStorageStatistics();
+    BufferPool::Statistics blocks = BufferPool::GetBlockStatistics();
+    TC_LOG_INFO("network", "WorldSocket::LogPacketAllocations: packet storage " UI64FMTD " reused, " UI64FMTD " allocated, " UI64FMTD " returned, " UI64FMTD " freed",
+        storage.Hits, storage.Misses, storage.Released, storage.Dropped);
+    TC_LOG_INFO("network", "WorldSocket::LogPacketAllocations: packet objects " UI64FMTD " reused, " UI64FMTD " allocated, " UI64FMTD " returned, " UI64FMTD " freed",
+        blocks.Hits, blocks.Misses, blocks.Released, blocks.Dropped);
+}
+
 void WorldSocket::WritePacketToBuffer(EncryptablePacket const& packet, MessageBuffer& buffer)
 {
     ServerPktHeader header;
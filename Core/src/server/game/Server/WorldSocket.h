@@ -99,6 +99,9 @@ public:
     void SetWorldSession(WorldSession* session);
     void SetSendBufferSize(std::size_t sendBufferSize) { _sendBufferSize = sendBufferSize; }
 
+    /// writes heap allocated packets per opcode and BufferPool usage to the network logger
+    static void LogPacketAllocations(uint32 limit);
+
 protected:
     void OnClose() override;
     void ReadHandler() override;
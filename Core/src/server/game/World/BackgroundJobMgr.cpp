@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2008-2016 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BackgroundJobMgr.h"
+#include "Log.h"
+
+BackgroundJobMgr::~BackgroundJobMgr()
+{
+    // early exits never reach Deactivate(), results of unfinished jobs are dropped
+    _cancelationToken = true;
+    _queue.Cancel();
+
+    for (std::thread& thread : _workerThreads)
+        thread.join();
+
+    for (Job* job : _completedJobs)
+        delete job;
+}
+
+void BackgroundJobMgr::Activate(std::size_t numThreads)
+{
+    for (std::size_t i = 0; i < numThreads; ++i)
+        _workerThreads.push_back(std::thread(&BackgroundJobMgr::WorkerThread, this));
+}
+
+void BackgroundJobMgr::Deactivate()
+{
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        while (_runningJobs > 0)
+            _condition.wait(lock);
+    }
+
+    _cancelationToken = true;
+    _queue.Cancel();
+
+    for (std::thread& thread : _workerThreads)
+        thread.join();
+
+    _workerThreads.clear();
+
+    ProcessCompleted();
+}
+
+bool BackgroundJobMgr::Schedule(std::string const& name, WorkFunction&& work)
+{
+    if (!_scheduledNames.insert(name).second)
+    {
+        TC_LOG_DEBUG("misc", "BackgroundJobMgr: job %s is still running, skipped.", name.c_str());
+        return false;
+    }
+
+    Job* job = new Job();
+    job->Name = name;
+    job->Work = std::move(work);
+
+    if (!IsActivated())
+    {
+        // no worker threads, both steps run inline as before
+        job->Apply = job->Work();
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            _completedJobs.push_back(job);
+        }
+
+        ProcessCompleted();
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(_lock);
+    ++_runningJobs;
+    _queue.Push(job);
+    return true;
+}
+
+void BackgroundJobMgr::ProcessCompleted()
+{
+    std::vector<Job*> completed;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        completed.swap(_completedJobs);
+    }
+
+    for (Job* job : completed)
+    {
+        if (job->Apply)
+            job->Apply();
+
+        _scheduledNames.erase(job->Name);
+        delete job;
+    }
+}
+
+void BackgroundJobMgr::WorkerThread()
+{
+    while (1)
+    {
+        Job* job = nullptr;
+
+        _queue.WaitAndPop(job);
+
+        if (_cancelationToken || !job)
+        {
+            delete job;
+            return;
+        }
+
+        job->Apply = job->Work();
+        job->Work = nullptr;                                // release the captured snapshot on this thread
+
+        std::lock_guard<std::mutex> lock(_lock);
+        _completedJobs.push_back(job);
+        --_runningJobs;
+        _condition.notify_all();
+    }
+}
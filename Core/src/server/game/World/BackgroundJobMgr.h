@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2008-2016 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BackgroundJobMgr_h__
+#define BackgroundJobMgr_h__
+
+#include "Define.h"
+#include "ProducerConsumerQueue.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+/*
+ * Runs periodic world jobs in two steps: the work function runs on a worker thread
+ * and may only use what it captured and synchronous database queries, the function
+ * it returns applies the results on the world thread in ProcessCompleted().
+ * Without worker threads both steps run immediately in Schedule().
+ */
+class TC_GAME_API BackgroundJobMgr
+{
+    public:
+        typedef std::function<void()> ApplyFunction;
+        typedef std::function<ApplyFunction()> WorkFunction;
+
+        BackgroundJobMgr() : _cancelationToken(false), _runningJobs(0) { }
+        ~BackgroundJobMgr();
+
+        /// @return false if the previous job with the same name was not applied yet
+        bool Schedule(std::string const& name, WorkFunction&& work);
+
+        /// Applies the results of finished jobs, world thread only
+        void ProcessCompleted();
+
+        void Activate(std::size_t numThreads);
+        /// Waits for queued jobs to finish and applies them
+        void Deactivate();
+        bool IsActivated() const { return !_workerThreads.empty(); }
+
+    private:
+        struct Job
+        {
+            std::string Name;
+            WorkFunction Work;
+            ApplyFunction Apply;
+        };
+
+        void WorkerThread();
+
+        ProducerConsumerQueue<Job*> _queue;
+
+        std::vector<std::thread> _workerThreads;
+        std::atomic<bool> _cancelationToken;
+
+        std::mutex _lock;
+        std::condition_variable _condition;
+        std::size_t _runningJobs;                           // queued or executing
+        std::vector<Job*> _completedJobs;
+        std::unordered_set<std::string> _scheduledNames;    // until applied, only used by the world thread
+};
+
+#endif // BackgroundJobMgr_h__
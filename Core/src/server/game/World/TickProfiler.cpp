@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2008-2016 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TickProfiler.h"
+#include "Log.h"
+#include <algorithm>
+
+TickProfiler::TickProfiler() : _threshold(0), _historySize(0), _inTick(false), _currentMapCount(0)
+{
+    _current.Phases.reserve(32);
+    _currentMaps.reserve(MaxMapsPerTick + 1);
+}
+
+TickProfiler* TickProfiler::instance()
+{
+    static TickProfiler instance;
+    return &instance;
+}
+
+void TickProfiler::SetConfig(uint32 threshold, uint32 historySize)
+{
+    _threshold.store(threshold, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(_historyLock);
+    _historySize = historySize;
+    while (_history.size() > _historySize)
+        _history.pop_back();
+}
+
+void TickProfiler::BeginTick(uint32 diff)
+{
+    _inTick = IsEnabled();
+    if (!_inTick)
+        return;
+
+    _tickStart = _phaseStart = std::chrono::steady_clock::now();
+    _current.Diff = diff;
+    _current.Phases.clear();
+}
+
+void TickProfiler::RecordPhase(char const* name)
+{
+    if (!_inTick)
+        return;
+
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    uint64 micros = uint64(std::chrono::duration_cast<std::chrono::microseconds>(now - _phaseStart).count());
+    _phaseStart = now;
+
+    // phases behind a timer that did not pass take no measurable time
+    if (micros)
+        _current.Phases.emplace_back(name, micros);
+}
+
+void TickProfiler::RecordMapUpdate(uint32 mapId, uint32 instanceId, uint64 micros)
+{
+    if (!_inTick)
+        return;
+
+    std::lock_guard<std::mutex> lock(_mapLock);
+    ++_currentMapCount;
+    if (_currentMaps.size() >= MaxMapsPerTick && _currentMaps.back().Micros >= micros)
+        return;
+
+    MapEntry entry;
+    entry.MapId = mapId;
+    entry.InstanceId = instanceId;
+    entry.Micros = micros;
+    _currentMaps.insert(std::upper_bound(_currentMaps.begin(), _currentMaps.end(), entry, [](MapEntry const& left, MapEntry const& right)
+    {
+        return left.Micros > right.Micros;
+    }), entry);
+
+    if (_currentMaps.size() > MaxMapsPerTick)
+        _currentMaps.pop_back();
+}
+
+void TickProfiler::EndTick()
+{
+    if (!_inTick)
+        return;
+
+    _inTick = false;
+
+    uint64 total = uint64(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _tickStart).count());
+
+    // map updates are finished at this point, the lock only orders the memory
+    std::vector<MapEntry> maps;
+    uint32 mapCount;
+    {
+        std::lock_guard<std::mutex> lock(_mapLock);
+        maps.swap(_currentMaps);
+        mapCount = _currentMapCount;
+        _currentMapCount = 0;
+        _currentMaps.reserve(MaxMapsPerTick + 1);
+    }
+
+    if (total < uint64(_threshold.load(std::memory_order_relaxed)) * 1000)
+        return;
+
+    Tick tick;
+    tick.Time = time(nullptr);
+    tick.Diff = _current.Diff;
+    tick.TotalMicros = total;
+    tick.Phases = _current.Phases;
+    std::sort(tick.Phases.begin(), tick.Phases.end(), [](std::pair<char const*, uint64> const& left, std::pair<char const*, uint64> const& right)
+    {
+        return left.second > right.second;
+    });
+    tick.Maps = std::move(maps);
+    tick.MapCount = mapCount;
+
+    TC_LOG_INFO("misc", "Slow world tick: " UI64FMTD " ms, slowest phase %s (" UI64FMTD " ms).", total / 1000,
+        tick.Phases.empty() ? "none" : tick.Phases.front().first, tick.Phases.empty() ? 0 : tick.Phases.front().second / 1000);
+
+    std::lock_guard<std::mutex> lock(_historyLock);
+    if (!_historySize)
+        return;
+
+    if (_history.size() >= _historySize)
+        _history.pop_back();
+
+    _history.push_front(std::move(tick));
+}
+
+std::vector<TickProfiler::Tick> TickProfiler::GetSlowTicks(uint32 count) const
+{
+    std::lock_guard<std::mutex> lock(_historyLock);
+    return std::vector<Tick>(_history.begin(), _history.begin() + std::min<std::size_t>(count, _history.size()));
+}
+
+void TickProfiler::Reset()
+{
+    std::lock_guard<std::mutex> lock(_historyLock);
+    _history.clear();
+}
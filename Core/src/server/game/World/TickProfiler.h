@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2008-2016 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TickProfiler_h__
+#define TickProfiler_h__
+
+#include "Define.h"
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <deque>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/// Time spent in each phase of World::Update and in the slowest map updates, kept for the last slow ticks
+class TC_GAME_API TickProfiler
+{
+    public:
+        static uint32 const MaxMapsPerTick = 5;
+
+        struct MapEntry
+        {
+            uint32 MapId;
+            uint32 InstanceId;
+            uint64 Micros;
+        };
+
+        struct Tick
+        {
+            time_t Time;
+            uint32 Diff;                                    // time since the previous tick, in milliseconds
+            uint64 TotalMicros;                             // time spent in World::Update
+            std::vector<std::pair<char const*, uint64>> Phases;
+            std::vector<MapEntry> Maps;                     // slowest map updates of the tick, slowest first
+            uint32 MapCount;                                // maps updated during the tick
+        };
+
+        static TickProfiler* instance();
+
+        /// @param threshold ticks taking at least this many milliseconds are kept, 0 disables the profiler
+        void SetConfig(uint32 threshold, uint32 historySize);
+        bool IsEnabled() const { return _threshold.load(std::memory_order_relaxed) != 0; }
+
+        // world thread only
+        void BeginTick(uint32 diff);
+        /// Attributes the time since the previous phase (or the start of the tick) to `name`, which must be a string literal
+        void RecordPhase(char const* name);
+        void EndTick();
+
+        /// Called from map update threads
+        void RecordMapUpdate(uint32 mapId, uint32 instanceId, uint64 micros);
+
+        /// Last slow ticks, newest first
+        std::vector<Tick> GetSlowTicks(uint32 count) const;
+        void Reset();
+
+    private:
+        TickProfiler();
+
+        std::atomic<uint32> _threshold;
+        std::size_t _historySize;
+
+        bool _inTick;
+        std::chrono::steady_clock::time_point _tickStart;
+        std::chrono::steady_clock::time_point _phaseStart;
+        Tick _current;
+
+        std::mutex _mapLock;
+        std::vector<MapEntry> _currentMaps;
+        uint32 _currentMapCount;
+
+        mutable std::mutex _historyLock;
+        std::deque<Tick> _history;
+};
+
+#define sTickProfiler TickProfiler::instance()
+
+#endif // TickProfiler_h__
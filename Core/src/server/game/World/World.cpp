@@ -66,6 +66,7 @@
 #include "Metric.h"
 #include "SupportMgr.h"
 #include "TaxiPathGraph.h"
+#include "TickProfiler.h"
 #include "TransportMgr.h"
 #include "Unit.h"
 #include "VMapFactory.h"
@@ -90,6 +91,10 @@ TC_GAME_API float World::m_MaxVisibleDistanceInBGArenas   = DEFAULT_VISIBILITY_B
 TC_GAME_API int32 World::m_visibility_notify_periodOnContinents = DEFAULT_VISIBILITY_NOTIFY_PERIOD;
 TC_GAME_API int32 World::m_visibility_notify_periodInInstances  = DEFAULT_VISIBILITY_NOTIFY_PERIOD;
 TC_GAME_API int32 World::m_visibility_notify_periodInBGArenas   = DEFAULT_VISIBILITY_NOTIFY_PERIOD;
+TC_GAME_API float World::m_visibility_incremental_distance     = 10.0f;
+
+// a periodic guild save is spread over several updates instead of saving every guild in one
+uint32 const GUILD_SAVES_PER_UPDATE = 20;
 
 /// World constructor
 World::World()
@@ -135,6 +140,8 @@ World::World()
 /// World destructor
 World::~World()
 {
+    StopSessionUpdater();
+
     ///- Empty the kicked session set
     while (!m_sessions.empty())
     {
@@ -1265,6 +1272,7 @@ void World::LoadConfigSettings(bool reload)
     m_visibility_notify_periodOnContinents = sConfigMgr->GetIntDefault("Visibility.Notify.Period.OnContinents", DEFAULT_VISIBILITY_NOTIFY_PERIOD);
     m_visibility_notify_periodInInstances = sConfigMgr->GetIntDefault("Visibility.Notify.Period.InInstances",   DEFAULT_VISIBILITY_NOTIFY_PERIOD);
     m_visibility_notify_periodInBGArenas = sConfigMgr->GetIntDefault("Visibility.Notify.Period.InBGArenas",    DEFAULT_VISIBILITY_NOTIFY_PERIOD);
+    m_visibility_incremental_distance = std::max(0.0f, sConfigMgr->GetFloatDefault("Visibility.Incremental.Distance", 10.0f));
 
     ///- Load the CharDelete related config options
     m_int_configs[CONFIG_CHARDELETE_METHOD] = sConfigMgr->GetIntDefault("CharDelete.Method", 0);
@@ -1323,6 +1331,8 @@ void World::LoadConfigSettings(bool reload)
     bool enableIndoor = sConfigMgr->GetBoolDefault("vmap.enableIndoorCheck", true);
     bool enableLOS = sConfigMgr->GetBoolDefault("vmap.enableLOS", true);
     bool enableHeight = sConfigMgr->GetBoolDefault("vmap.enableHeight", true);
+    m_int_configs[CONFIG_LINE_OF_SIGHT_CACHE_SIZE] = sConfigMgr->GetIntDefault("vmap.LineOfSightCacheSize", 4096);
+    m_int_configs[CONFIG_FLOOR_HEIGHT_CACHE_SIZE] = sConfigMgr->GetIntDefault("vmap.FloorHeightCacheSize", 8192);
 
     if (!enableHeight)
         TC_LOG_ERROR("server.loading", "VMap height checking disabled! Creatures movements and other various things WILL be broken! Expect no support.");
@@ -1330,8 +1340,16 @@ void World::LoadConfigSettings(bool reload)
     VMAP::VMapFactory::createOrGetVMapManager()->setEnableLineOfSightCalc(enableLOS);
     VMAP::VMapFactory::createOrGetVMapManager()->setEnableHeightCalc(enableHeight);
     TC_LOG_INFO("server.loading", "VMap support included. LineOfSight: %i, getHeight: %i, indoorCheck: %i", enableLOS, enableHeight, enableIndoor);
+    if (VMAP::VMapManager2* vmmgr2 = dynamic_cast<VMAP::VMapManager2*>(VMAP::VMapFactory::createOrGetVMapManager()))
+    {
+        vmmgr2->setEnableSimdIntersection(sConfigMgr->GetBoolDefault("vmap.enableSimdIntersection", true));
+        TC_LOG_INFO("server.loading", "VMap SIMD triangle tests: %i", vmmgr2->isSimdIntersectionEnabled());
+    }
     TC_LOG_INFO("server.loading", "VMap data directory is: %svmaps", m_dataPath.c_str());
 
+    GridMap::SetMemoryMapped(sConfigMgr->GetBoolDefault("MapFiles.MemoryMapped", false));
+    TC_LOG_INFO("server.loading", "Memory mapped map files: %i", GridMap::IsMemoryMapped());
+
     m_int_configs[CONFIG_MAX_WHO] = sConfigMgr->GetIntDefault("MaxWhoListReturns", 49);
     m_bool_configs[CONFIG_START_ALL_SPELLS] = sConfigMgr->GetBoolDefault("PlayerStart.AllSpells", false);
     if (m_bool_configs[CONFIG_START_ALL_SPELLS])
@@ -1357,6 +1375,8 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_INTERVAL_LOG_UPDATE] = sConfigMgr->GetIntDefault("RecordUpdateTimeDiffInterval", 60000);
     m_int_configs[CONFIG_MIN_LOG_UPDATE] = sConfigMgr->GetIntDefault("MinRecordUpdateTimeDiff", 100);
     m_int_configs[CONFIG_NUMTHREADS] = sConfigMgr->GetIntDefault("MapUpdate.Threads", 1);
+    m_int_configs[CONFIG_SESSION_UPDATE_THREADS] = sConfigMgr->GetIntDefault("SessionUpdate.Threads", 0);
+    m_int_configs[CONFIG_BACKGROUND_JOB_THREADS] = sConfigMgr->GetIntDefault("BackgroundJobs.Threads", 1);
     m_int_configs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = sConfigMgr->GetIntDefault("Command.LookupMaxResults", 0);
 
     // Warden
@@ -1452,6 +1472,13 @@ void World::LoadConfigSettings(bool reload)
 
     m_int_configs[CONFIG_PACKET_SPOOF_BANDURATION] = sConfigMgr->GetIntDefault("PacketSpoof.BanDuration", 86400);
 
+    m_bool_configs[CONFIG_OPCODE_PROFILER_ENABLED] = sConfigMgr->GetBoolDefault("OpcodeProfiler.Enabled", false);
+    m_int_configs[CONFIG_OPCODE_PROFILER_SESSION_BUDGET] = sConfigMgr->GetIntDefault("OpcodeProfiler.SessionBudget", 0);
+
+    m_int_configs[CONFIG_TICK_PROFILER_THRESHOLD] = sConfigMgr->GetIntDefault("TickProfiler.SlowTickThreshold", 100);
+    m_int_configs[CONFIG_TICK_PROFILER_HISTORY] = sConfigMgr->GetIntDefault("TickProfiler.History", 20);
+    sTickProfiler->SetConfig(m_int_configs[CONFIG_TICK_PROFILER_THRESHOLD], m_int_configs[CONFIG_TICK_PROFILER_HISTORY]);
+
     m_bool_configs[CONFIG_IP_BASED_ACTION_LOGGING] = sConfigMgr->GetBoolDefault("Allow.IP.Based.Action.Logging", false);
 
     // AHBot
@@ -1474,6 +1501,8 @@ void World::LoadConfigSettings(bool reload)
     m_bool_configs[CONFIG_HOTSWAP_INSTALL_ENABLED] = sConfigMgr->GetBoolDefault("HotSwap.EnableInstall", true);
     m_bool_configs[CONFIG_HOTSWAP_PREFIX_CORRECTION_ENABLED] = sConfigMgr->GetBoolDefault("HotSwap.EnablePrefixCorrection", true);
 
+    m_bool_configs[CONFIG_SMARTAI_PROFILING] = sConfigMgr->GetBoolDefault("SmartAI.Profiling", false);
+
     // call ScriptMgr if we're reloading the configuration
     if (reload)
         sScriptMgr->OnConfigLoad(reload);
@@ -2062,6 +2091,18 @@ void World::SetInitialWorldSettings()
     TC_LOG_INFO("server.loading", "Starting Map System");
     sMapMgr->Initialize();
 
+    if (uint32 sessionThreads = getIntConfig(CONFIG_SESSION_UPDATE_THREADS))
+    {
+        TC_LOG_INFO("server.loading", "Starting %u session update threads", sessionThreads);
+        m_sessionUpdater.Activate(sessionThreads);
+    }
+
+    if (uint32 jobThreads = getIntConfig(CONFIG_BACKGROUND_JOB_THREADS))
+    {
+        TC_LOG_INFO("server.loading", "Starting %u background job threads", jobThreads);
+        m_backgroundJobs.Activate(jobThreads);
+    }
+
     TC_LOG_INFO("server.loading", "Starting Game Event system...");
     uint32 nextGameEvent = sGameEventMgr->StartSystem();
     m_timers[WUPDATE_EVENTS].SetInterval(nextGameEvent);    //depend on next event
@@ -2171,8 +2212,10 @@ void World::ResetTimeDiffRecord()
     m_currentTime = getMSTime();
 }
 
-void World::RecordTimeDiff(std::string const& text)
+void World::RecordTimeDiff(char const* text)
 {
+    sTickProfiler->RecordPhase(text);
+
     if (m_updateTimeCount != 1)
         return;
 
@@ -2180,7 +2223,7 @@ void World::RecordTimeDiff(std::string const& text)
     uint32 diff = getMSTimeDiff(m_currentTime, thisTime);
 
     if (diff > m_int_configs[CONFIG_MIN_LOG_UPDATE])
-        TC_LOG_INFO("misc", "Difftime %s: %u.", text.c_str(), diff);
+        TC_LOG_INFO("misc", "Difftime %s: %u.", text, diff);
 
     m_currentTime = thisTime;
 }
@@ -2223,6 +2266,7 @@ void World::LoadAutobroadcasts()
 void World::Update(uint32 diff)
 {
     m_updateTime = diff;
+    sTickProfiler->BeginTick(diff);
 
     if (m_int_configs[CONFIG_INTERVAL_LOG_UPDATE] && diff > m_int_configs[CONFIG_MIN_LOG_UPDATE])
     {
@@ -2275,6 +2319,8 @@ void World::Update(uint32 diff)
     if (m_gameTime > m_NextCurrencyReset)
         ResetCurrencyWeekCap();
 
+    RecordTimeDiff("Resets");
+
     /// <ul><li> Handle auctions when the timer has passed
     if (m_timers[WUPDATE_AUCTIONS].Passed())
     {
@@ -2285,12 +2331,13 @@ void World::Update(uint32 diff)
         if (++mail_timer > mail_timer_expires)
         {
             mail_timer = 0;
-            sObjectMgr->ReturnOrDeleteOldMails(true);
+            ScheduleReturnOrDeleteOldMails();
         }
 
         ///- Handle expired auctions
         sAuctionMgr->Update();
     }
+    RecordTimeDiff("Auctions");
 
     if (m_timers[WUPDATE_AUCTIONS_PENDING].Passed())
     {
@@ -2298,6 +2345,7 @@ void World::Update(uint32 diff)
 
         sAuctionMgr->UpdatePendingAuctions();
     }
+    RecordTimeDiff("PendingAuctions");
 
     if (m_timers[WUPDATE_BLACKMARKET].Passed())
     {
@@ -2317,6 +2365,7 @@ void World::Update(uint32 diff)
             sBlackMarketMgr->Update();
         }
     }
+    RecordTimeDiff("BlackMarket");
 
     /// <li> Handle AHBot operations
     if (m_timers[WUPDATE_AHBOT].Passed())
@@ -2324,6 +2373,7 @@ void World::Update(uint32 diff)
         sAuctionBot->Update();
         m_timers[WUPDATE_AHBOT].Reset();
     }
+    RecordTimeDiff("AuctionBot");
 
     /// <li> Handle file changes
     if (m_timers[WUPDATE_CHECK_FILECHANGES].Passed())
@@ -2331,6 +2381,7 @@ void World::Update(uint32 diff)
         sScriptReloadMgr->Update();
         m_timers[WUPDATE_CHECK_FILECHANGES].Reset();
     }
+    RecordTimeDiff("ScriptReload");
 
     /// <li> Handle session updates when the timer has passed
     ResetTimeDiffRecord();
@@ -2343,6 +2394,7 @@ void World::Update(uint32 diff)
         m_timers[WUPDATE_WEATHERS].Reset();
         WeatherMgr::Update(uint32(m_timers[WUPDATE_WEATHERS].GetInterval()));
     }
+    RecordTimeDiff("Weathers");
 
     /// <li> Update uptime table
     if (m_timers[WUPDATE_UPTIME].Passed())
@@ -2377,6 +2429,7 @@ void World::Update(uint32 diff)
             LoginDatabase.Execute(stmt);
         }
     }
+    RecordTimeDiff("Uptime");
 
     /// <li> Handle all other objects
     ///- Update objects when the timer has passed (maps, transport, creatures, ...)
@@ -2392,6 +2445,7 @@ void World::Update(uint32 diff)
             SendAutoBroadcast();
         }
     }
+    RecordTimeDiff("AutoBroadcast");
 
     sBattlegroundMgr->Update(diff);
     RecordTimeDiff("UpdateBattlegroundMgr");
@@ -2406,8 +2460,9 @@ void World::Update(uint32 diff)
     if (m_timers[WUPDATE_DELETECHARS].Passed())
     {
         m_timers[WUPDATE_DELETECHARS].Reset();
-        Player::DeleteOldCharacters();
+        ScheduleDeleteOldCharacters();
     }
+    RecordTimeDiff("DeleteOldCharacters");
 
     sLFGMgr->Update(diff);
     RecordTimeDiff("UpdateLFGMgr");
@@ -2419,6 +2474,10 @@ void World::Update(uint32 diff)
     ProcessQueryCallbacks();
     RecordTimeDiff("ProcessQueryCallbacks");
 
+    // apply the results of periodic jobs that finished on the background threads
+    m_backgroundJobs.ProcessCompleted();
+    RecordTimeDiff("BackgroundJobs");
+
     ///- Erase corpses once every 20 minutes
     if (m_timers[WUPDATE_CORPSES].Passed())
     {
@@ -2428,6 +2487,7 @@ void World::Update(uint32 diff)
             map->RemoveOldCorpses();
         });
     }
+    RecordTimeDiff("RemoveOldCorpses");
 
     ///- Process Game events when necessary
     if (m_timers[WUPDATE_EVENTS].Passed())
@@ -2437,6 +2497,7 @@ void World::Update(uint32 diff)
         m_timers[WUPDATE_EVENTS].SetInterval(nextGameEvent);
         m_timers[WUPDATE_EVENTS].Reset();
     }
+    RecordTimeDiff("GameEvents");
 
     ///- Ping to keep MySQL connections alive
     if (m_timers[WUPDATE_PINGDB].Passed())
@@ -2446,25 +2507,42 @@ void World::Update(uint32 diff)
         CharacterDatabase.KeepAlive();
         LoginDatabase.KeepAlive();
         WorldDatabase.KeepAlive();
+
+        CharacterDatabase.LogStatementLatency(10);
+        LoginDatabase.LogStatementLatency(10);
+        WorldDatabase.LogStatementLatency(10);
+        HotfixDatabase.LogStatementLatency(10);
     }
+    RecordTimeDiff("PingDB");
 
     if (m_timers[WUPDATE_GUILDSAVE].Passed())
     {
         m_timers[WUPDATE_GUILDSAVE].Reset();
-        sGuildMgr->SaveGuilds();
+        sGuildMgr->QueueGuildSaves();
     }
+    sGuildMgr->SaveQueuedGuilds(GUILD_SAVES_PER_UPDATE);
+    RecordTimeDiff("SaveGuilds");
 
     // update the instance reset times
     sInstanceSaveMgr->Update();
+    RecordTimeDiff("InstanceSaveMgr");
 
     // And last, but not least handle the issued cli commands
     ProcessCliCommands();
+    RecordTimeDiff("ProcessCliCommands");
 
     sScriptMgr->OnWorldUpdate(diff);
+    RecordTimeDiff("ScriptMgr");
 
     // Stats logger update
     sMetric->Update();
     TC_METRIC_VALUE("update_time_diff", diff);
+    TC_METRIC_HISTOGRAM("world_update_time_diff_ms", diff);
+    TC_METRIC_GAUGE("online_players", GetPlayerCount());
+    Trinity::VisibilityStatistics::LogMetrics();
+    RecordTimeDiff("Metrics");
+
+    sTickProfiler->EndTick();
 }
 
 void World::ForceGameEventUpdate()
@@ -2972,6 +3050,14 @@ void World::UpdateSessions(uint32 diff)
     while (addSessQueue.next(sess))
         AddSession_ (sess);
 
+    std::chrono::steady_clock::time_point parallelStart = std::chrono::steady_clock::now();
+
+    ///- Handle the session-local packets on the session update threads
+    if (m_sessionUpdater.IsActivated())
+        ProcessSessionLocalPackets();
+
+    std::chrono::steady_clock::time_point serialStart = std::chrono::steady_clock::now();
+
     ///- Then send an update signal to remaining ones
     for (SessionMap::iterator itr = m_sessions.begin(), next; itr != m_sessions.end(); itr = next)
     {
@@ -2992,6 +3078,108 @@ void World::UpdateSessions(uint32 diff)
 
         }
     }
+
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    TC_METRIC_VALUE("update_sessions_parallel_time", uint64(std::chrono::duration_cast<std::chrono::microseconds>(serialStart - parallelStart).count()));
+    TC_METRIC_VALUE("update_sessions_serial_time", uint64(std::chrono::duration_cast<std::chrono::microseconds>(end - serialStart).count()));
+}
+
+void World::ProcessSessionLocalPackets()
+{
+    std::size_t batchCount = m_sessionUpdater.GetThreadCount();
+    std::vector<std::vector<WorldSession*>> batches(batchCount);
+
+    // players on the same map must stay on one thread, the handlers may touch the player
+    // and objects around it; sessions without a player in world can go anywhere
+    std::unordered_map<Map const*, std::vector<WorldSession*>> sessionsByMap;
+    std::vector<std::vector<WorldSession*>*> groups;
+    std::vector<std::vector<WorldSession*>> singles;
+    singles.reserve(m_sessions.size());
+    for (SessionMap::const_iterator itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
+    {
+        WorldSession* session = itr->second;
+        Player* player = session->GetPlayer();
+        if (player && player->IsInWorld())
+        {
+            std::vector<WorldSession*>& group = sessionsByMap[player->GetMap()];
+            if (group.empty())
+                groups.push_back(&group);
+            group.push_back(session);
+        }
+        else
+        {
+            singles.emplace_back(1, session);
+            groups.push_back(&singles.back());
+        }
+    }
+
+    // biggest groups first, each to the batch with the fewest sessions so far
+    std::sort(groups.begin(), groups.end(), [](std::vector<WorldSession*> const* left, std::vector<WorldSession*> const* right)
+    {
+        return left->size() > right->size();
+    });
+
+    for (std::vector<WorldSession*> const* group : groups)
+    {
+        std::vector<WorldSession*>& batch = *std::min_element(batches.begin(), batches.end(), [](std::vector<WorldSession*> const& left, std::vector<WorldSession*> const& right)
+        {
+            return left.size() < right.size();
+        });
+
+        batch.insert(batch.end(), group->begin(), group->end());
+    }
+
+    for (std::vector<WorldSession*>& batch : batches)
+        if (!batch.empty())
+            m_sessionUpdater.ScheduleBatch(std::move(batch));
+
+    m_sessionUpdater.Wait();
+}
+
+void World::StopSessionUpdater()
+{
+    if (m_sessionUpdater.IsActivated())
+        m_sessionUpdater.Deactivate();
+}
+
+void World::StopBackgroundJobs()
+{
+    if (m_backgroundJobs.IsActivated())
+        m_backgroundJobs.Deactivate();
+}
+
+void World::ScheduleReturnOrDeleteOldMails()
+{
+    uint64 basetime = uint64(time(NULL));
+    TC_LOG_INFO("misc", "Returning mails expired before " UI64FMTD, basetime);
+
+    m_backgroundJobs.Schedule("ReturnOrDeleteOldMails", [basetime]() -> BackgroundJobMgr::ApplyFunction
+    {
+        std::shared_ptr<ExpiredMailList> mails = std::make_shared<ExpiredMailList>(ObjectMgr::LoadExpiredMails(basetime));
+        return [mails, basetime]()
+        {
+            // the receiver may have come online and loaded the mails meanwhile, checked here
+            sObjectMgr->ReturnOrDeleteExpiredMails(*mails, basetime, true);
+        };
+    });
+}
+
+void World::ScheduleDeleteOldCharacters()
+{
+    uint32 keepDays = getIntConfig(CONFIG_CHARDELETE_KEEP_DAYS);
+    if (!keepDays)
+        return;
+
+    TC_LOG_INFO("entities.player", "Player::DeleteOldCharacters: Deleting all characters which have been deleted %u days before...", keepDays);
+
+    m_backgroundJobs.Schedule("DeleteOldCharacters", [keepDays]() -> BackgroundJobMgr::ApplyFunction
+    {
+        std::shared_ptr<std::vector<Player::OldCharacter>> characters = std::make_shared<std::vector<Player::OldCharacter>>(Player::SelectOldCharacters(keepDays));
+        return [characters]()
+        {
+            Player::DeleteOldCharacters(*characters);
+        };
+    });
 }
 
 // This handles the issued and queued CLI commands
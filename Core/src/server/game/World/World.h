@@ -31,6 +31,8 @@
 #include "QueryResult.h"
 #include "QueryCallback.h"
 #include "Realm/Realm.h"
+#include "WorldSessionUpdater.h"
+#include "BackgroundJobMgr.h"
 
 #include <atomic>
 #include <map>
@@ -189,6 +191,8 @@ enum WorldBoolConfigs
     CONFIG_HOTSWAP_BUILD_FILE_RECREATION_ENABLED,
     CONFIG_HOTSWAP_INSTALL_ENABLED,
     CONFIG_HOTSWAP_PREFIX_CORRECTION_ENABLED,
+    CONFIG_SMARTAI_PROFILING,
+    CONFIG_OPCODE_PROFILER_ENABLED,
     BOOL_CONFIG_VALUE_COUNT
 };
 
@@ -398,6 +402,13 @@ enum WorldIntConfigs
     CONFIG_TALENTS_INSPECTING,
     CONFIG_BLACKMARKET_MAXAUCTIONS,
     CONFIG_BLACKMARKET_UPDATE_PERIOD,
+    CONFIG_OPCODE_PROFILER_SESSION_BUDGET,
+    CONFIG_SESSION_UPDATE_THREADS,
+    CONFIG_TICK_PROFILER_THRESHOLD,
+    CONFIG_TICK_PROFILER_HISTORY,
+    CONFIG_BACKGROUND_JOB_THREADS,
+    CONFIG_LINE_OF_SIGHT_CACHE_SIZE,
+    CONFIG_FLOOR_HEIGHT_CACHE_SIZE,
     INT_CONFIG_VALUE_COUNT
 };
 
@@ -694,6 +705,8 @@ class TC_GAME_API World
         void Update(uint32 diff);
 
         void UpdateSessions(uint32 diff);
+        void StopSessionUpdater();
+        void StopBackgroundJobs();
         /// Set a server rate (see #Rates)
         void setRate(Rates rate, float value) { rate_values[rate]=value; }
         /// Get a server rate (see #Rates)
@@ -762,6 +775,7 @@ class TC_GAME_API World
         static int32 GetVisibilityNotifyPeriodOnContinents(){ return m_visibility_notify_periodOnContinents; }
         static int32 GetVisibilityNotifyPeriodInInstances() { return m_visibility_notify_periodInInstances;  }
         static int32 GetVisibilityNotifyPeriodInBGArenas()  { return m_visibility_notify_periodInBGArenas;   }
+        static float GetVisibilityIncrementalDistance()     { return m_visibility_incremental_distance;      }
 
         void ProcessCliCommands();
         void QueueCliCommand(CliCommandHolder* commandHolder) { cliCmdQueue.add(commandHolder); }
@@ -777,7 +791,7 @@ class TC_GAME_API World
         char const* GetDBVersion() const { return m_DBVersion.c_str(); }
 
         void ResetTimeDiffRecord();
-        void RecordTimeDiff(std::string const& text);
+        void RecordTimeDiff(char const* text);
 
         void LoadAutobroadcasts();
 
@@ -840,6 +854,12 @@ class TC_GAME_API World
         uint32 m_currentTime;
 
         SessionMap m_sessions;
+        WorldSessionUpdater m_sessionUpdater;
+        BackgroundJobMgr m_backgroundJobs;
+        void ScheduleReturnOrDeleteOldMails();
+        void ScheduleDeleteOldCharacters();
+        void ProcessSessionLocalPackets();
+
         typedef std::unordered_map<uint32, time_t> DisconnectMap;
         DisconnectMap m_disconnects;
         uint32 m_maxActiveSessionCount;
@@ -876,6 +896,7 @@ class TC_GAME_API World
         static int32 m_visibility_notify_periodOnContinents;
         static int32 m_visibility_notify_periodInInstances;
         static int32 m_visibility_notify_periodInBGArenas;
+        static float m_visibility_incremental_distance;
 
         // CLI command holder to be thread safe
         LockedQueue<CliCommandHolder*> cliCmdQueue;
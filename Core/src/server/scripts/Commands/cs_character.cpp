@@ -366,7 +366,9 @@ public:
 
             if (target)
             {
+                std::string oldName = target->GetName();
                 target->SetName(newName);
+                ObjectAccessor::UpdatePlayerName(target, oldName);
 
                 if (WorldSession* session = target->GetSession())
                     session->KickPlayer();
@@ -26,8 +26,10 @@ EndScriptData */
 #include "Config.h"
 #include "Language.h"
 #include "ObjectAccessor.h"
+#include "OpcodeProfiler.h"
 #include "Player.h"
 #include "ScriptMgr.h"
+#include "TickProfiler.h"
 #include "GitRevision.h"
 #include "Util.h"
 
@@ -70,6 +72,12 @@ public:
             { "closed",   rbac::RBAC_PERM_COMMAND_SERVER_SET_CLOSED,   true, &HandleServerSetClosedCommand,   "" },
         };
 
+        static std::vector<ChatCommand> serverProfileCommandTable =
+        {
+            { "opcodes", rbac::RBAC_PERM_COMMAND_SERVER_PROFILE_OPCODES, true, &HandleServerProfileOpcodesCommand, "" },
+            { "ticks",   rbac::RBAC_PERM_COMMAND_SERVER_PROFILE_TICKS,   true, &HandleServerProfileTicksCommand,   "" },
+        };
+
         static std::vector<ChatCommand> serverCommandTable =
         {
             { "corpses",      rbac::RBAC_PERM_COMMAND_SERVER_CORPSES,      true, &HandleServerCorpsesCommand, "" },
@@ -79,6 +87,7 @@ public:
             { "info",         rbac::RBAC_PERM_COMMAND_SERVER_INFO,         true, &HandleServerInfoCommand,    "" },
             { "motd",         rbac::RBAC_PERM_COMMAND_SERVER_MOTD,         true, &HandleServerMotdCommand,    "" },
             { "plimit",       rbac::RBAC_PERM_COMMAND_SERVER_PLIMIT,       true, &HandleServerPLimitCommand,  "" },
+            { "profile",      rbac::RBAC_PERM_COMMAND_SERVER_PROFILE,      true, NULL,                        "", serverProfileCommandTable },
             { "restart",      rbac::RBAC_PERM_COMMAND_SERVER_RESTART,      true, NULL,                        "", serverRestartCommandTable },
             { "shutdown",     rbac::RBAC_PERM_COMMAND_SERVER_SHUTDOWN,     true, NULL,                        "", serverShutdownCommandTable },
             { "set",          rbac::RBAC_PERM_COMMAND_SERVER_SET,          true, NULL,                        "", serverSetCommandTable },
@@ -120,6 +129,93 @@ public:
 
         return true;
     }
+
+    // .server profile opcodes [count|reset]
+    static bool HandleServerProfileOpcodesCommand(ChatHandler* handler, char const* args)
+    {
+        if (!sWorld->getBoolConfig(CONFIG_OPCODE_PROFILER_ENABLED))
+        {
+            handler->SendSysMessage("Opcode profiler is disabled (OpcodeProfiler.Enabled).");
+            return true;
+        }
+
+        uint32 count = 20;
+        if (*args)
+        {
+            if (strcmp(args, "reset") == 0)
+            {
+                sOpcodeProfiler->Reset();
+                handler->SendSysMessage("Opcode profiler counters reset.");
+                return true;
+            }
+
+            count = uint32(atoi(args));
+            if (!count)
+                return false;
+        }
+
+        std::vector<OpcodeProfiler::Entry> entries = sOpcodeProfiler->GetTopEntries(count);
+        handler->PSendSysMessage("Top %u opcodes by handler time:", uint32(entries.size()));
+        for (OpcodeProfiler::Entry const& entry : entries)
+            handler->PSendSysMessage("%s (%s): " UI64FMTD " calls, " UI64FMTD " bytes, " UI64FMTD " us total, avg " UI64FMTD " us, p50 <" UI64FMTD " us, p99 <" UI64FMTD " us, max " UI64FMTD " us",
+                GetOpcodeNameForLogging(static_cast<OpcodeClient>(entry.Opcode)).c_str(), OpcodeProfiler::GetProcessingPlaceName(entry.ProcessingPlace),
+                entry.Count, entry.Bytes, entry.TotalMicros, entry.TotalMicros / entry.Count, entry.Percentile50, entry.Percentile99, entry.MaxMicros);
+
+        return true;
+    }
+
+    // .server profile ticks [count|reset]
+    static bool HandleServerProfileTicksCommand(ChatHandler* handler, char const* args)
+    {
+        if (!sTickProfiler->IsEnabled())
+        {
+            handler->SendSysMessage("Tick profiler is disabled (TickProfiler.SlowTickThreshold).");
+            return true;
+        }
+
+        uint32 count = 3;
+        if (*args)
+        {
+            if (strcmp(args, "reset") == 0)
+            {
+                sTickProfiler->Reset();
+                handler->SendSysMessage("Slow tick history cleared.");
+                return true;
+            }
+
+            count = uint32(atoi(args));
+            if (!count)
+                return false;
+        }
+
+        std::vector<TickProfiler::Tick> ticks = sTickProfiler->GetSlowTicks(count);
+        if (ticks.empty())
+        {
+            handler->PSendSysMessage("No world tick took longer than %u ms.", sWorld->getIntConfig(CONFIG_TICK_PROFILER_THRESHOLD));
+            return true;
+        }
+
+        for (TickProfiler::Tick const& tick : ticks)
+        {
+            handler->PSendSysMessage("%s: tick took %.1f ms (diff %u ms), %u maps updated",
+                TimeToTimestampStr(tick.Time).c_str(), tick.TotalMicros / 1000.0, tick.Diff, tick.MapCount);
+
+            for (std::pair<char const*, uint64> const& phase : tick.Phases)
+            {
+                uint32 percent = uint32(phase.second * 100 / std::max<uint64>(tick.TotalMicros, 1));
+                if (!percent)
+                    break;
+
+                handler->PSendSysMessage("  %-22s %8.1f ms %3u%% %s", phase.first, phase.second / 1000.0, percent, std::string(percent / 5, '#').c_str());
+                if (strcmp(phase.first, "UpdateMapMgr") == 0)
+                    for (TickProfiler::MapEntry const& map : tick.Maps)
+                        handler->PSendSysMessage("    map %u instance %u: %.1f ms", map.MapId, map.InstanceId, map.Micros / 1000.0);
+            }
+        }
+
+        return true;
+    }
+
     // Display the 'Message of the day' for the realm
     static bool HandleServerMotdCommand(ChatHandler* handler, char const* /*args*/)
     {
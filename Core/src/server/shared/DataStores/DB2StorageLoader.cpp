@@ -30,6 +30,7 @@ DB2FileLoader::DB2FileLoader()
     fieldsOffset = nullptr;
     data = nullptr;
     stringTable = nullptr;
+    producedStringsSize = 0;
 
     tableHash = 0;
     build = 0;
@@ -43,125 +44,59 @@ DB2FileLoader::DB2FileLoader()
 
 bool DB2FileLoader::Load(const char *filename, const char *fmt)
 {
-    if (data)
-    {
-        delete[] data;
-        data = nullptr;
-    }
+    data = nullptr;
 
-    FILE* f = fopen(filename, "rb");
-    if (!f)
+    // records are used straight from the mapped file, AutoProduceData copies them into the store
+    if (!file.Open(filename))
         return false;
 
     fileName = filename;
     uint32 header;
-    if (fread(&header, 4, 1, f) != 1)                        // Signature
-    {
-        fclose(f);
+    if (!file.Read(header))                                 // Signature
         return false;
-    }
-
-    EndianConvert(header);
 
     if (header != 0x32424457)
-    {
-        fclose(f);
         return false;                                       //'WDB2'
-    }
 
-    if (fread(&recordCount, 4, 1, f) != 1)                 // Number of records
-    {
-        fclose(f);
+    if (!file.Read(recordCount))                            // Number of records
         return false;
-    }
-
-    EndianConvert(recordCount);
 
-    if (fread(&fieldCount, 4, 1, f) != 1)                 // Number of fields
-    {
-        fclose(f);
+    if (!file.Read(fieldCount))                             // Number of fields
         return false;
-    }
-
-    EndianConvert(fieldCount);
 
-    if (fread(&recordSize, 4, 1, f) != 1)                 // Size of a record
-    {
-        fclose(f);
+    if (!file.Read(recordSize))                             // Size of a record
         return false;
-    }
-
-    EndianConvert(recordSize);
 
-    if (fread(&stringSize, 4, 1, f) != 1)                 // String size
-    {
-        fclose(f);
+    if (!file.Read(stringSize))                             // String size
         return false;
-    }
-
-    EndianConvert(stringSize);
 
     /* NEW WDB2 FIELDS*/
-    if (fread(&tableHash, 4, 1, f) != 1)                  // Table hash
-    {
-        fclose(f);
+    if (!file.Read(tableHash))                              // Table hash
         return false;
-    }
-
-    EndianConvert(tableHash);
 
-    if (fread(&build, 4, 1, f) != 1)                     // Build
-    {
-        fclose(f);
+    if (!file.Read(build))                                  // Build
         return false;
-    }
-
-    EndianConvert(build);
 
-    if (fread(&unk1, 4, 1, f) != 1)                     // Unknown WDB2
-    {
-        fclose(f);
+    if (!file.Read(unk1))                                   // Unknown WDB2
         return false;
-    }
-
-    EndianConvert(unk1);
 
-    if (fread(&minIndex, 4, 1, f) != 1)                           // MinIndex WDB2
-    {
-        fclose(f);
+    if (!file.Read(minIndex))                               // MinIndex WDB2
         return false;
-    }
-
-    EndianConvert(minIndex);
 
-    if (fread(&maxIndex, 4, 1, f) != 1)                           // MaxIndex WDB2
-    {
-        fclose(f);
+    if (!file.Read(maxIndex))                               // MaxIndex WDB2
         return false;
-    }
-
-    EndianConvert(maxIndex);
 
-    if (fread(&localeMask, 4, 1, f) != 1)                             // Locales
-    {
-        fclose(f);
+    if (!file.Read(localeMask))                             // Locales
         return false;
-    }
-
-    EndianConvert(localeMask);
 
-    if (fread(&unk5, 4, 1, f) != 1)                               // Unknown WDB2
-    {
-        fclose(f);
+    if (!file.Read(unk5))                                   // Unknown WDB2
         return false;
-    }
-
-    EndianConvert(unk5);
 
     if (maxIndex != 0)
     {
         int32 diff = maxIndex - minIndex + 1;
-        fseek(f, diff * 4 + diff * 2, SEEK_CUR);    // diff * 4: an index for rows, diff * 2: a memory allocation bank
+        if (!file.Consume(diff * 4 + diff * 2))             // diff * 4: an index for rows, diff * 2: a memory allocation bank
+            return false;
     }
 
     fieldsOffset = new uint32[fieldCount];
@@ -177,23 +112,16 @@ bool DB2FileLoader::Load(const char *filename, const char *fmt)
             fieldsOffset[i] += 4;
     }
 
-    data = new unsigned char[recordSize * recordCount + stringSize];
-    stringTable = data + recordSize * recordCount;
-
-    if (fread(data, recordSize * recordCount + stringSize, 1, f) != 1)
-    {
-        fclose(f);
+    data = file.Consume(std::size_t(recordSize) * recordCount + stringSize);
+    if (!data)
         return false;
-    }
 
-    fclose(f);
+    stringTable = data + recordSize * recordCount;
     return true;
 }
 
 DB2FileLoader::~DB2FileLoader()
 {
-    if (data)
-        delete [] data;
     if (fieldsOffset)
         delete [] fieldsOffset;
 }
@@ -430,8 +358,8 @@ char* DB2FileLoader::AutoProduceStrings(const char* format, char* dataTable, uin
         return nullptr;
     }
 
-    char* stringPool = new char[stringSize];
-    memcpy(stringPool, stringTable, stringSize);
+    // only strings that end up in a slot are copied
+    DBStringPoolBuilder stringPool(stringTable, stringSize);
 
     uint32 offset = 0;
 
@@ -457,19 +385,15 @@ char* DB2FileLoader::AutoProduceStrings(const char* format, char* dataTable, uin
                     // fill only not filled entries
                     LocalizedString* db2str = *(LocalizedString**)(&dataTable[offset]);
                     if (db2str->Str[locale] == nullStr)
-                    {
-                        char const* st = getRecord(y).getString(x);
-                        db2str->Str[locale] = stringPool + (st - (char const*)stringTable);
-                    }
+                        stringPool.Add(&db2str->Str[locale], getRecord(y).getString(x));
 
                     offset += sizeof(char*);
                     break;
                 }
                 case FT_STRING_NOT_LOCALIZED:
                 {
-                    char** db2str = (char**)(&dataTable[offset]);
-                    char const* st = getRecord(y).getString(x);
-                    *db2str = stringPool + (st - (char const*)stringTable);
+                    char const** db2str = (char const**)(&dataTable[offset]);
+                    stringPool.Add(db2str, getRecord(y).getString(x));
                     offset += sizeof(char*);
                     break;
                 }
@@ -477,7 +401,9 @@ char* DB2FileLoader::AutoProduceStrings(const char* format, char* dataTable, uin
         }
     }
 
-    return stringPool;
+    char* pool = stringPool.Build();
+    producedStringsSize = stringPool.GetSize();
+    return pool;
 }
 
 char* DB2DatabaseLoader::Load(const char* format, HotfixDatabaseStatements preparedStatement, uint32& records, char**& indexTable, char*& stringHolders, std::list<char*>& stringPool)
@@ -21,6 +21,7 @@
 #include "Define.h"
 #include "Utilities/ByteConverter.h"
 #include "Implementation/HotfixDatabase.h"
+#include "DBFileMapping.h"
 #include <cassert>
 #include <list>
 
@@ -38,26 +39,26 @@ class TC_SHARED_API DB2FileLoader
         float getFloat(size_t field) const
         {
             assert(field < file.fieldCount);
-            float val = *reinterpret_cast<float*>(offset + file.GetOffset(field));
+            float val = *reinterpret_cast<float const*>(offset + file.GetOffset(field));
             EndianConvert(val);
             return val;
         }
         uint32 getUInt(size_t field) const
         {
             assert(field < file.fieldCount);
-            uint32 val = *reinterpret_cast<uint32*>(offset + file.GetOffset(field));
+            uint32 val = *reinterpret_cast<uint32 const*>(offset + file.GetOffset(field));
             EndianConvert(val);
             return val;
         }
         uint8 getUInt8(size_t field) const
         {
             assert(field < file.fieldCount);
-            return *reinterpret_cast<uint8*>(offset + file.GetOffset(field));
+            return *reinterpret_cast<uint8 const*>(offset + file.GetOffset(field));
         }
         uint64 getUInt64(size_t field) const
         {
             assert(field < file.fieldCount);
-            uint64 val = *reinterpret_cast<uint64*>(offset + file.GetOffset(field));
+            uint64 val = *reinterpret_cast<uint64 const*>(offset + file.GetOffset(field));
             EndianConvert(val);
             return val;
         }
@@ -66,12 +67,12 @@ class TC_SHARED_API DB2FileLoader
             assert(field < file.fieldCount);
             size_t stringOffset = getUInt(field);
             assert(stringOffset < file.stringSize);
-            return reinterpret_cast<char*>(file.stringTable + stringOffset);
+            return reinterpret_cast<char const*>(file.stringTable + stringOffset);
         }
 
     private:
-        Record(DB2FileLoader &file_, unsigned char *offset_): offset(offset_), file(file_) {}
-        unsigned char *offset;
+        Record(DB2FileLoader &file_, unsigned char const* offset_): offset(offset_), file(file_) {}
+        unsigned char const* offset;
         DB2FileLoader &file;
 
         friend class DB2FileLoader;
@@ -89,10 +90,13 @@ class TC_SHARED_API DB2FileLoader
     char* AutoProduceData(const char* fmt, uint32& count, char**& indexTable);
     char* AutoProduceStringsArrayHolders(const char* fmt, char* dataTable);
     char* AutoProduceStrings(const char* fmt, char* dataTable, uint32 locale);
+    /// Size of the pool returned by the last AutoProduceStrings call
+    uint32 GetProducedStringsSize() const { return producedStringsSize; }
     static uint32 GetFormatRecordSize(const char * format, int32 * index_pos = NULL);
     static uint32 GetFormatStringFieldCount(const char * format);
     static uint32 GetFormatLocalizedStringFieldCount(const char * format);
 private:
+    DBFileMapping file;
     char const* fileName;
 
     uint32 recordSize;
@@ -100,8 +104,9 @@ private:
     uint32 fieldCount;
     uint32 stringSize;
     uint32 *fieldsOffset;
-    unsigned char *data;
-    unsigned char *stringTable;
+    unsigned char const* data;                              // points into file
+    unsigned char const* stringTable;
+    uint32 producedStringsSize;
 
     // WDB2 / WCH2 fields
     uint32 tableHash;    // WDB2
@@ -49,7 +49,8 @@ public:
     typedef DBStorageIterator<T> iterator;
 
     DB2Storage(char const* fileName, char const* format, HotfixDatabaseStatements preparedStmtIndex)
-        : _fileName(fileName), _indexTableSize(0), _fieldCount(0), _format(format), _dataTable(nullptr), _dataTableEx(nullptr), _hotfixStatement(preparedStmtIndex)
+        : _fileName(fileName), _indexTableSize(0), _fieldCount(0), _format(format), _dataTable(nullptr), _dataTableEx(nullptr), _hotfixStatement(preparedStmtIndex),
+        _memoryUsage(0)
     {
         _indexTable.AsT = NULL;
     }
@@ -131,6 +132,8 @@ public:
     uint32 GetNumRows() const { return _indexTableSize; }
     char const* GetFormat() const { return _format; }
     uint32 GetFieldCount() const { return _fieldCount; }
+    /// Bytes allocated for the index, records and strings loaded from files, hotfix rows are not counted
+    std::size_t GetMemoryUsage() const { return _memoryUsage; }
     bool Load(std::string const& path, uint32 locale)
     {
         DB2FileLoader db2;
@@ -151,9 +154,14 @@ public:
 
             // load strings from db2 data
             if (char* stringBlock = db2.AutoProduceStrings(_format, (char*)_dataTable, locale))
+            {
                 _stringPoolList.push_back(stringBlock);
+                _memoryUsage += db2.GetProducedStringsSize();
+            }
         }
 
+        _memoryUsage += _indexTableSize * sizeof(T*) + db2.GetNumRows() * sizeof(T);
+
         // error in db2 file at loading if NULL
         return _indexTable.AsT != NULL;
     }
@@ -171,8 +179,13 @@ public:
 
         // load strings from another locale db2 data
         if (DB2FileLoader::GetFormatLocalizedStringFieldCount(_format))
+        {
             if (char* stringBlock = db2.AutoProduceStrings(_format, (char*)_dataTable, locale))
+            {
                 _stringPoolList.push_back(stringBlock);
+                _memoryUsage += db2.GetProducedStringsSize();
+            }
+        }
         return true;
     }
 
@@ -219,6 +232,7 @@ private:
     T* _dataTableEx;
     StringPoolList _stringPoolList;
     HotfixDatabaseStatements _hotfixStatement;
+    std::size_t _memoryUsage;
 };
 
 #endif
@@ -23,67 +23,34 @@
 #include "DBCFileLoader.h"
 #include "Errors.h"
 
-DBCFileLoader::DBCFileLoader() : recordSize(0), recordCount(0), fieldCount(0), stringSize(0), fieldsOffset(NULL), data(NULL), stringTable(NULL) { }
+DBCFileLoader::DBCFileLoader() : recordSize(0), recordCount(0), fieldCount(0), stringSize(0), fieldsOffset(NULL), data(NULL), stringTable(NULL), producedStringsSize(0) { }
 
 bool DBCFileLoader::Load(const char* filename, const char* fmt)
 {
     uint32 header;
-    if (data)
-    {
-        delete [] data;
-        data = NULL;
-    }
+    data = NULL;
 
-    FILE* f = fopen(filename, "rb");
-    if (!f)
+    // records are used straight from the mapped file, AutoProduceData copies them into the store
+    if (!file.Open(filename))
         return false;
 
-    if (fread(&header, 4, 1, f) != 1)                        // Number of records
-    {
-        fclose(f);
+    if (!file.Read(header))                                 // Number of records
         return false;
-    }
-
-
-    EndianConvert(header);
 
     if (header != 0x43424457)                                //'WDBC'
-    {
-        fclose(f);
         return false;
-    }
 
-    if (fread(&recordCount, 4, 1, f) != 1)                   // Number of records
-    {
-        fclose(f);
+    if (!file.Read(recordCount))                            // Number of records
         return false;
-    }
-
-    EndianConvert(recordCount);
 
-    if (fread(&fieldCount, 4, 1, f) != 1)                    // Number of fields
-    {
-        fclose(f);
+    if (!file.Read(fieldCount))                             // Number of fields
         return false;
-    }
-
-    EndianConvert(fieldCount);
 
-    if (fread(&recordSize, 4, 1, f) != 1)                    // Size of a record
-    {
-        fclose(f);
+    if (!file.Read(recordSize))                             // Size of a record
         return false;
-    }
 
-    EndianConvert(recordSize);
-
-    if (fread(&stringSize, 4, 1, f) != 1)                    // String size
-    {
-        fclose(f);
+    if (!file.Read(stringSize))                             // String size
         return false;
-    }
-
-    EndianConvert(stringSize);
 
     fieldsOffset = new uint32[fieldCount];
     fieldsOffset[0] = 0;
@@ -98,24 +65,16 @@ bool DBCFileLoader::Load(const char* filename, const char* fmt)
             fieldsOffset[i] += sizeof(uint32);
     }
 
-    data = new unsigned char[recordSize * recordCount + stringSize];
-    stringTable = data + recordSize*recordCount;
-
-    if (fread(data, recordSize * recordCount + stringSize, 1, f) != 1)
-    {
-        fclose(f);
+    data = file.Consume(std::size_t(recordSize) * recordCount + stringSize);
+    if (!data)
         return false;
-    }
-
-    fclose(f);
 
+    stringTable = data + recordSize*recordCount;
     return true;
 }
 
 DBCFileLoader::~DBCFileLoader()
 {
-    delete[] data;
-
     delete[] fieldsOffset;
 }
 
@@ -274,8 +233,8 @@ char* DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable)
     if (strlen(format) != fieldCount)
         return NULL;
 
-    char* stringPool = new char[stringSize];
-    memcpy(stringPool, stringTable, stringSize);
+    // only strings that end up in a slot are copied, locale files usually fill few of them
+    DBStringPoolBuilder stringPool(stringTable, stringSize);
 
     uint32 offset = 0;
 
@@ -301,12 +260,9 @@ char* DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable)
                 case FT_STRING:
                 {
                     // fill only not filled entries
-                    char** slot = (char**)(&dataTable[offset]);
+                    char const** slot = (char const**)(&dataTable[offset]);
                     if (!*slot || !**slot)
-                    {
-                        const char * st = getRecord(y).getString(x);
-                        *slot=stringPool+(st-(const char*)stringTable);
-                    }
+                        stringPool.Add(slot, getRecord(y).getString(x));
                     offset += sizeof(char*);
                     break;
                  }
@@ -321,5 +277,7 @@ char* DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable)
         }
     }
 
-    return stringPool;
+    char* pool = stringPool.Build();
+    producedStringsSize = stringPool.GetSize();
+    return pool;
 }
@@ -21,6 +21,7 @@
 
 #include "Define.h"
 #include "Utilities/ByteConverter.h"
+#include "DBFileMapping.h"
 #include <cassert>
 
 class TC_SHARED_API DBCFileLoader
@@ -37,26 +38,26 @@ class TC_SHARED_API DBCFileLoader
                 float getFloat(size_t field) const
                 {
                     assert(field < file.fieldCount);
-                    float val = *reinterpret_cast<float*>(offset + file.GetOffset(field));
+                    float val = *reinterpret_cast<float const*>(offset + file.GetOffset(field));
                     EndianConvert(val);
                     return val;
                 }
                 uint32 getUInt(size_t field) const
                 {
                     assert(field < file.fieldCount);
-                    uint32 val = *reinterpret_cast<uint32*>(offset + file.GetOffset(field));
+                    uint32 val = *reinterpret_cast<uint32 const*>(offset + file.GetOffset(field));
                     EndianConvert(val);
                     return val;
                 }
                 uint8 getUInt8(size_t field) const
                 {
                     assert(field < file.fieldCount);
-                    return *reinterpret_cast<uint8*>(offset + file.GetOffset(field));
+                    return *reinterpret_cast<uint8 const*>(offset + file.GetOffset(field));
                 }
                 uint64 getUInt64(size_t field) const
                 {
                     assert(field < file.fieldCount);
-                    uint64 val = *reinterpret_cast<uint64*>(offset + file.GetOffset(field));
+                    uint64 val = *reinterpret_cast<uint64 const*>(offset + file.GetOffset(field));
                     EndianConvert(val);
                     return val;
                 }
@@ -65,12 +66,12 @@ class TC_SHARED_API DBCFileLoader
                     assert(field < file.fieldCount);
                     size_t stringOffset = getUInt(field);
                     assert(stringOffset < file.stringSize);
-                    return reinterpret_cast<char*>(file.stringTable + stringOffset);
+                    return reinterpret_cast<char const*>(file.stringTable + stringOffset);
                 }
 
             private:
-                Record(DBCFileLoader &file_, unsigned char *offset_): offset(offset_), file(file_) { }
-                unsigned char* offset;
+                Record(DBCFileLoader &file_, unsigned char const* offset_): offset(offset_), file(file_) { }
+                unsigned char const* offset;
                 DBCFileLoader& file;
 
                 friend class DBCFileLoader;
@@ -88,16 +89,20 @@ class TC_SHARED_API DBCFileLoader
         bool IsLoaded() const { return data != NULL; }
         char* AutoProduceData(const char* fmt, uint32& count, char**& indexTable, uint32 sqlRecordCount, uint32 sqlHighestIndex, char *& sqlDataTable);
         char* AutoProduceStrings(const char* fmt, char* dataTable);
+        /// Size of the pool returned by the last AutoProduceStrings call
+        uint32 GetProducedStringsSize() const { return producedStringsSize; }
         static uint32 GetFormatRecordSize(const char * format, int32 * index_pos = NULL);
     private:
+        DBFileMapping file;
 
         uint32 recordSize;
         uint32 recordCount;
         uint32 fieldCount;
         uint32 stringSize;
         uint32 *fieldsOffset;
-        unsigned char *data;
-        unsigned char *stringTable;
+        unsigned char const* data;                          // points into file
+        unsigned char const* stringTable;
+        uint32 producedStringsSize;
 
         DBCFileLoader(DBCFileLoader const& right) = delete;
         DBCFileLoader& operator=(DBCFileLoader const& right) = delete;
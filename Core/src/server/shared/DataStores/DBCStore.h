@@ -79,7 +79,7 @@ class DBCStorage
         typedef DBStorageIterator<T> iterator;
 
         explicit DBCStorage(char const* f)
-            : fmt(f), nCount(0), fieldCount(0), dataTable(NULL)
+            : fmt(f), nCount(0), fieldCount(0), dataTable(NULL), memoryUsage(0)
         {
             indexTable.asT = NULL;
         }
@@ -101,6 +101,8 @@ class DBCStorage
         uint32  GetNumRows() const { return nCount; }
         char const* GetFormat() const { return fmt; }
         uint32 GetFieldCount() const { return fieldCount; }
+        /// Bytes allocated for the index, records and strings
+        std::size_t GetMemoryUsage() const { return memoryUsage; }
 
         bool Load(char const* fn, SqlDbc* sql)
         {
@@ -148,6 +150,7 @@ class DBCStorage
                 sqlRecordCount, sqlHighestIndex, sqlDataTable));
 
             stringPoolList.push_back(dbc.AutoProduceStrings(fmt, reinterpret_cast<char*>(dataTable)));
+            memoryUsage = nCount * sizeof(T*) + (dbc.GetNumRows() + sqlRecordCount) * sizeof(T) + dbc.GetProducedStringsSize();
 
             // Insert sql data into arrays
             if (result)
@@ -277,6 +280,7 @@ class DBCStorage
                 return false;
 
             stringPoolList.push_back(dbc.AutoProduceStrings(fmt, reinterpret_cast<char*>(dataTable)));
+            memoryUsage += dbc.GetProducedStringsSize();
 
             return true;
         }
@@ -298,6 +302,7 @@ class DBCStorage
             }
 
             nCount = 0;
+            memoryUsage = 0;
         }
 
         iterator begin() { return iterator(indexTable.asT, nCount); }
@@ -317,6 +322,7 @@ class DBCStorage
 
         T* dataTable;
         StringPoolList stringPoolList;
+        std::size_t memoryUsage;
 
         DBCStorage(DBCStorage const& right) = delete;
         DBCStorage& operator=(DBCStorage const& right) = delete;
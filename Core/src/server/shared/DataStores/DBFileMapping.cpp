@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2008-2016 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DBFileMapping.h"
+#include "Utilities/ByteConverter.h"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <algorithm>
+#include <cstring>
+
+DBFileMapping::DBFileMapping() : _position(0), _fileMissing(false) { }
+
+DBFileMapping::~DBFileMapping() { }
+
+bool DBFileMapping::Open(char const* filename)
+{
+    Close();
+
+    try
+    {
+        // the region stays mapped after the file is closed at the end of this scope
+        boost::interprocess::file_mapping file(filename, boost::interprocess::read_only);
+        _region.reset(new boost::interprocess::mapped_region(file, boost::interprocess::read_only));
+    }
+    catch (boost::interprocess::interprocess_exception const& e)
+    {
+        _fileMissing = e.get_error_code() == boost::interprocess::not_found_error;
+        _error = e.what();
+        _region.reset();
+        return false;
+    }
+
+    return true;
+}
+
+void DBFileMapping::Close()
+{
+    _region.reset();
+    _position = 0;
+    _fileMissing = false;
+    _error.clear();
+}
+
+bool DBFileMapping::Read(uint32& value)
+{
+    unsigned char const* bytes = Consume(sizeof(uint32));
+    if (!bytes)
+        return false;
+
+    memcpy(&value, bytes, sizeof(uint32));
+    EndianConvert(value);
+    return true;
+}
+
+bool DBFileMapping::Read(int32& value)
+{
+    unsigned char const* bytes = Consume(sizeof(int32));
+    if (!bytes)
+        return false;
+
+    memcpy(&value, bytes, sizeof(int32));
+    EndianConvert(value);
+    return true;
+}
+
+bool DBFileMapping::Seek(std::size_t position)
+{
+    if (!_region || position > GetSize())
+        return false;
+
+    _position = position;
+    return true;
+}
+
+unsigned char const* DBFileMapping::GetData() const
+{
+    return _region ? reinterpret_cast<unsigned char const*>(_region->get_address()) : NULL;
+}
+
+unsigned char const* DBFileMapping::Consume(std::size_t size)
+{
+    if (!_region || size > GetSize() - _position)
+        return NULL;
+
+    unsigned char const* bytes = GetData() + _position;
+    _position += size;
+    return bytes;
+}
+
+std::size_t DBFileMapping::GetSize() const
+{
+    return _region ? _region->get_size() : 0;
+}
+
+void DBStringPoolBuilder::Add(char const** slot, char const* string)
+{
+    _slots.emplace_back(uint32(reinterpret_cast<unsigned char const*>(string) - _stringTable), slot);
+}
+
+char* DBStringPoolBuilder::Build()
+{
+    std::sort(_slots.begin(), _slots.end());
+
+    // offset 0 is the empty string shared by all empty fields
+    _size = 1;
+    uint32 lastOffset = 0;
+    for (std::pair<uint32, char const**> const& slot : _slots)
+    {
+        if (slot.first != lastOffset && slot.first < _stringSize)
+            _size += uint32(strnlen(reinterpret_cast<char const*>(_stringTable) + slot.first, _stringSize - slot.first)) + 1;
+        lastOffset = slot.first;
+    }
+
+    char* pool = new char[_size];
+    pool[0] = '\0';
+
+    uint32 position = 1;
+    uint32 lastPosition = 0;
+    lastOffset = 0;
+    for (std::pair<uint32, char const**> const& slot : _slots)
+    {
+        if (slot.first >= _stringSize)
+        {
+            *slot.second = pool;
+            continue;
+        }
+
+        if (slot.first != lastOffset)
+        {
+            char const* string = reinterpret_cast<char const*>(_stringTable) + slot.first;
+            uint32 length = uint32(strnlen(string, _stringSize - slot.first));
+            memcpy(pool + position, string, length);
+            pool[position + length] = '\0';
+            lastPosition = position;
+            position += length + 1;
+            lastOffset = slot.first;
+        }
+
+        *slot.second = pool + lastPosition;
+    }
+
+    _slots.clear();
+    return pool;
+}
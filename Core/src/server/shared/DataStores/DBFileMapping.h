@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2008-2016 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DBFileMapping_h__
+#define DBFileMapping_h__
+
+#include "Define.h"
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace boost
+{
+    namespace interprocess
+    {
+        class mapped_region;
+    }
+}
+
+/// Read only memory mapping of a data file, read sequentially from the start or from a position set with Seek
+/// The file is closed once it is mapped, a mapping does not hold a file descriptor
+class TC_SHARED_API DBFileMapping
+{
+    public:
+        DBFileMapping();
+        ~DBFileMapping();
+
+        /// @return false on failure, IsFileMissing and GetError tell why
+        bool Open(char const* filename);
+        void Close();
+
+        /// true if the last Open failed because the file does not exist
+        bool IsFileMissing() const { return _fileMissing; }
+        char const* GetError() const { return _error.c_str(); }
+
+        /// Reads the next little endian value, false if the file is too short
+        bool Read(uint32& value);
+        bool Read(int32& value);
+        /// @return the next size bytes, NULL if the file is too short
+        unsigned char const* Consume(std::size_t size);
+        /// @return false if position is past the end of the file
+        bool Seek(std::size_t position);
+
+        unsigned char const* GetData() const;
+        std::size_t GetSize() const;
+
+    private:
+        std::unique_ptr<boost::interprocess::mapped_region> _region;
+        std::size_t _position;
+        bool _fileMissing;
+        std::string _error;
+
+        DBFileMapping(DBFileMapping const& right) = delete;
+        DBFileMapping& operator=(DBFileMapping const& right) = delete;
+};
+
+/// Copies the strings records point to out of a file string table, unused strings are left behind
+class TC_SHARED_API DBStringPoolBuilder
+{
+    public:
+        DBStringPoolBuilder(unsigned char const* stringTable, uint32 stringSize) : _stringTable(stringTable), _stringSize(stringSize), _size(0) { }
+
+        /// slot is set to the copy of the string at offset by Build()
+        void Add(char const** slot, char const* string);
+
+        /// @return new pool starting with an empty string, owned by the caller
+        char* Build();
+        /// Bytes allocated by the last Build()
+        uint32 GetSize() const { return _size; }
+
+    private:
+        unsigned char const* _stringTable;
+        uint32 _stringSize;
+        std::vector<std::pair<uint32, char const**>> _slots;
+        uint32 _size;
+};
+
+#endif // DBFileMapping_h__
@@ -22,6 +22,7 @@
 #include "Define.h"
 #include "Errors.h"
 #include "ByteConverter.h"
+#include "BufferPool.h"
 #include "Util.h"
 
 
@@ -67,19 +68,27 @@ class TC_SHARED_API ByteBuffer
         // constructor
         ByteBuffer() : _rpos(0), _wpos(0), _bitpos(InitialBitPos), _curbitval(0)
         {
-            _storage.reserve(DEFAULT_SIZE);
+            BufferPool::Acquire(_storage, DEFAULT_SIZE);
         }
 
         ByteBuffer(size_t reserve) : _rpos(0), _wpos(0), _bitpos(InitialBitPos), _curbitval(0)
         {
-            _storage.reserve(reserve);
+            if (reserve)
+                BufferPool::Acquire(_storage, reserve);
         }
 
         ByteBuffer(ByteBuffer&& buf) : _rpos(buf._rpos), _wpos(buf._wpos),
             _bitpos(buf._bitpos), _curbitval(buf._curbitval), _storage(buf.Move()) { }
 
         ByteBuffer(ByteBuffer const& right) : _rpos(right._rpos), _wpos(right._wpos),
-            _bitpos(right._bitpos), _curbitval(right._curbitval), _storage(right._storage) { }
+            _bitpos(right._bitpos), _curbitval(right._curbitval)
+        {
+            if (!right._storage.empty())
+            {
+                BufferPool::Acquire(_storage, right._storage.size());
+                _storage.assign(right._storage.begin(), right._storage.end());
+            }
+        }
 
         ByteBuffer(MessageBuffer&& buffer);
 
@@ -114,13 +123,17 @@ class TC_SHARED_API ByteBuffer
                 _wpos = right._wpos;
                 _bitpos = right._bitpos;
                 _curbitval = right._curbitval;
+                BufferPool::Release(_storage);
                 _storage = right.Move();
             }
 
             return *this;
         }
 
-        virtual ~ByteBuffer() { }
+        virtual ~ByteBuffer()
+        {
+            BufferPool::Release(_storage);
+        }
 
         void clear()
         {
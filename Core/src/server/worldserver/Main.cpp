@@ -27,6 +27,7 @@
 #include "BigNumber.h"
 #include "CliRunnable.h"
 #include "Configuration/Config.h"
+#include "CriteriaHandler.h"
 #include "DatabaseEnv.h"
 #include "DatabaseLoader.h"
 #include "DeadlineTimer.h"
@@ -37,6 +38,7 @@
 #include "Metric.h"
 #include "MySQLThreading.h"
 #include "ObjectAccessor.h"
+#include "OpcodeProfiler.h"
 #include "OpenSSLCrypto.h"
 #include "OutdoorPvP/OutdoorPvPMgr.h"
 #include "ProcessPriority.h"
@@ -45,6 +47,7 @@
 #include "ScriptLoader.h"
 #include "ScriptMgr.h"
 #include "ScriptReloadMgr.h"
+#include "SmartScriptMgr.h"
 #include "TCSoap.h"
 #include "World.h"
 #include "WorldSocket.h"
@@ -257,6 +260,11 @@ extern int main(int argc, char** argv)
     sMetric->Initialize(realm.Name, *ioContext, []()
         {
             TC_METRIC_VALUE("online_players", sWorld->GetPlayerCount());
+            sOpcodeProfiler->LogMetrics();
+
+            Log::QueueStatistics logStats = sLog->GetQueueStatistics();
+            TC_METRIC_VALUE("log_queued_messages", logStats.Queued);
+            TC_METRIC_VALUE("log_dropped_messages", logStats.Dropped);
         });
 
     TC_METRIC_EVENT("events", "Worldserver started", "");
@@ -327,6 +335,8 @@ extern int main(int argc, char** argv)
         {
             sWorld->KickAll();                                       // save and kick all players
             sWorld->UpdateSessions(1);                             // real players unload required UpdateSessions call
+            sWorld->StopSessionUpdater();
+            sWorld->StopBackgroundJobs();
 
             sWorldSocketMgr.StopNetwork();
 
@@ -369,6 +379,11 @@ extern int main(int argc, char** argv)
     // Shutdown starts here
     threadPool.reset();
 
+    sCriteriaMgr->LogUpdateStatistics();
+    if (sWorld->getBoolConfig(CONFIG_SMARTAI_PROFILING))
+        sSmartScriptMgr->LogProfile(50);
+    WorldSocket::LogPacketAllocations(20);
+
     sLog->SetSynchronous();
 
     sScriptMgr->OnShutdown();
@@ -18,12 +18,15 @@
 
 #define _CRT_SECURE_NO_DEPRECATE
 
+#include <atomic>
 #include <cstdio>
 #include <deque>
 #include <fstream>
 #include <set>
 #include <cstdlib>
 #include <cstring>
+#include <thread>
+#include <vector>
 
 #include <boost/filesystem/path.hpp>
 #include <boost/filesystem/operations.hpp>
@@ -36,6 +39,7 @@
 #include "CascLib.h"
 #include "dbcfile.h"
 #include "StringFormat.h"
+#include "Timer.h"
 
 #include "adt.h"
 #include "wdt.h"
@@ -105,6 +109,9 @@ float CONF_flat_liquid_delta_limit = 0.001f; // If max - min less this value - l
 
 uint32 CONF_Locale = 0;
 
+// Threads converting ADT tiles, each of them opens its own CASC storage
+uint32 CONF_Threads = std::max(std::thread::hardware_concurrency(), 1u);
+
 #define CASC_LOCALES_COUNT 17
 
 char const* CascLocaleNames[CASC_LOCALES_COUNT] =
@@ -156,6 +163,7 @@ void Usage(char const* prg)
         "-e extract only MAP(1)/DBC(2) - standard: both(3)\n"\
         "-f height stored as int (less map size but lost some accuracy) 1 by default\n"\
         "-l dbc locale\n"\
+        "-t number of threads converting map tiles - standard: number of cores\n"\
         "Example: %s -f 0 -i \"c:\\games\\game\"\n", prg, MAX_PATH_LENGTH - 1, MAX_PATH_LENGTH - 1, prg);
     exit(1);
 }
@@ -170,6 +178,7 @@ void HandleArgs(int argc, char* arg[])
         // f - use float to int conversion
         // h - limit minimum height
         // b - target client build
+        // t - map tile threads
         if (arg[c][0] != '-')
             Usage(arg[0]);
 
@@ -220,6 +229,16 @@ void HandleArgs(int argc, char* arg[])
                 else
                     Usage(arg[0]);
                 break;
+            case 't':
+                if (c + 1 < argc)                            // all ok
+                {
+                    CONF_Threads = atoi(arg[c++ + 1]);
+                    if (!CONF_Threads)
+                        Usage(arg[0]);
+                }
+                else
+                    Usage(arg[0]);
+                break;
             case 'h':
                 Usage(arg[0]);
                 break;
@@ -427,24 +446,24 @@ float selectUInt16StepStore(float maxDiff)
 {
     return 65535 / maxDiff;
 }
-// Temporary grid data store
-uint16 area_ids[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+// Temporary grid data store, one per extraction thread
+thread_local uint16 area_ids[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
 
-float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
-uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint16 uint16_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
-uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint8  uint8_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+thread_local float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local float V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+thread_local uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local uint16 uint16_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+thread_local uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local uint8  uint8_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
 
-uint16 liquid_entry[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-uint8 liquid_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float liquid_height[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
-uint8 holes[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID][8];
+thread_local uint16 liquid_entry[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+thread_local uint8 liquid_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+thread_local bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local float liquid_height[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+thread_local uint8 holes[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID][8];
 
-int16 flight_box_max[3][3];
-int16 flight_box_min[3][3];
+thread_local int16 flight_box_max[3][3];
+thread_local int16 flight_box_min[3][3];
 
 bool TransformToHighRes(uint16 lowResHoles, uint8 hiResHoles[8])
 {
@@ -461,11 +480,11 @@ bool TransformToHighRes(uint16 lowResHoles, uint8 hiResHoles[8])
     return *((uint64*)hiResHoles) != 0;
 }
 
-bool ConvertADT(std::string const& inputPath, std::string const& outputPath, int /*cell_y*/, int /*cell_x*/, uint32 build)
+bool ConvertADT(HANDLE storage, std::string const& inputPath, std::string const& outputPath, int /*cell_y*/, int /*cell_x*/, uint32 build)
 {
     ChunkedFile adt;
 
-    if (!adt.loadFile(CascStorage, inputPath))
+    if (!adt.loadFile(storage, inputPath))
         return false;
 
     // Prepare map header
@@ -1026,13 +1045,57 @@ void ExtractWmos(ChunkedFile& file, std::set<std::string>& wmoList)
     }
 }
 
-void ExtractMaps(uint32 build)
+bool OpenCascStorage(int locale, HANDLE& storage);
+
+struct MapTile
+{
+    uint32 MapIndex;
+    uint32 X;
+    uint32 Y;
+};
+
+struct MapTileQueue
+{
+    std::vector<MapTile> Tiles;                             // in map and grid order
+    std::atomic<std::size_t> NextTile;
+    std::atomic<std::size_t> ConvertedTiles;
+};
+
+void ExtractMapTiles(HANDLE storage, MapTileQueue& queue, std::set<std::string>& wmoList, uint32 build)
 {
     std::string storagePath;
     std::string outputFileName;
 
+    std::size_t const tileCount = queue.Tiles.size();
+    for (std::size_t i = queue.NextTile++; i < tileCount; i = queue.NextTile++)
+    {
+        MapTile const& tile = queue.Tiles[i];
+        map_id const& map = map_ids[tile.MapIndex];
+
+        storagePath = Trinity::StringFormat("World\\Maps\\%s\\%s_%u_%u.adt", map.name, map.name, tile.X, tile.Y);
+        outputFileName = Trinity::StringFormat("%s/maps/%04u_%02u_%02u.map", output_path, map.id, tile.Y, tile.X);
+        ConvertADT(storage, storagePath, outputFileName, tile.Y, tile.X, build);
+
+        storagePath = Trinity::StringFormat("World\\Maps\\%s\\%s_%u_%u_obj0.adt", map.name, map.name, tile.X, tile.Y);
+        ChunkedFile adtObj;
+        if (adtObj.loadFile(storage, storagePath, false))
+            ExtractWmos(adtObj, wmoList);
+
+        // draw progress bar
+        std::size_t converted = ++queue.ConvertedTiles;
+        if ((100 * converted) / tileCount != (100 * (converted - 1)) / tileCount)
+            printf("Processing........................%u%%\r", uint32((100 * converted) / tileCount));
+    }
+}
+
+void ExtractMaps(uint32 build, int locale)
+{
+    std::string storagePath;
+
     printf("Extracting maps...\n");
 
+    uint32 startTime = getMSTime();
+
     uint32 map_count = ReadMapDBC();
 
     ReadLiquidTypeTableDBC();
@@ -1043,41 +1106,55 @@ void ExtractMaps(uint32 build)
 
     std::set<std::string> wmoList;
 
-    printf("Convert map files\n");
+    // WDT files are small, read them all first and hand the tiles out to the threads
+    MapTileQueue queue;
+    queue.NextTile = 0;
+    queue.ConvertedTiles = 0;
+    uint32 extractedMaps = 0;
     for (uint32 z = 0; z < map_count; ++z)
     {
-        printf("Extract %s (%d/%u)                  \n", map_ids[z].name, z+1, map_count);
-        // Loadup map grid data
         storagePath = Trinity::StringFormat("World\\Maps\\%s\\%s.wdt", map_ids[z].name, map_ids[z].name);
         ChunkedFile wdt;
         if (!wdt.loadFile(CascStorage, storagePath, false))
             continue;
 
+        ++extractedMaps;
         ExtractWmos(wdt, wmoList);
 
         FileChunk* chunk = wdt.GetChunk("MAIN");
         for (uint32 y = 0; y < WDT_MAP_SIZE; ++y)
-        {
             for (uint32 x = 0; x < WDT_MAP_SIZE; ++x)
-            {
-                if (!(chunk->As<wdt_MAIN>()->adt_list[y][x].flag & 0x1))
-                    continue;
+                if (chunk->As<wdt_MAIN>()->adt_list[y][x].flag & 0x1)
+                    queue.Tiles.push_back({ z, x, y });
+    }
 
-                storagePath = Trinity::StringFormat("World\\Maps\\%s\\%s_%u_%u.adt", map_ids[z].name, map_ids[z].name, x, y);
-                outputFileName =  Trinity::StringFormat("%s/maps/%04u_%02u_%02u.map", output_path, map_ids[z].id, y, x);
-                ConvertADT(storagePath, outputFileName, y, x, build);
+    uint32 threadCount = std::min<uint32>(CONF_Threads, std::max<uint32>(uint32(queue.Tiles.size()), 1));
+    printf("Convert %u map files of %u maps using %u threads\n", uint32(queue.Tiles.size()), extractedMaps, threadCount);
 
-                storagePath = Trinity::StringFormat("World\\Maps\\%s\\%s_%u_%u_obj0.adt", map_ids[z].name, map_ids[z].name, x, y);
-                ChunkedFile adtObj;
-                if (adtObj.loadFile(CascStorage, storagePath, false))
-                    ExtractWmos(adtObj, wmoList);
-            }
+    // every tile writes its own file and the wmo lists are sets, so the output does not depend on the order tiles finish in
+    std::vector<std::set<std::string>> threadWmoLists(threadCount);
+    std::vector<std::thread> threads;
+    for (uint32 i = 1; i < threadCount; ++i)
+    {
+        threads.push_back(std::thread([&queue, &threadWmoLists, build, locale, i]()
+        {
+            HANDLE storage = NULL;
+            if (!OpenCascStorage(locale, storage))
+                return;
 
-            // draw progress bar
-            printf("Processing........................%d%%\r", (100 * (y+1)) / WDT_MAP_SIZE);
-        }
+            ExtractMapTiles(storage, queue, threadWmoLists[i], build);
+            CascCloseStorage(storage);
+        }));
     }
 
+    ExtractMapTiles(CascStorage, queue, threadWmoLists[0], build);
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    for (std::set<std::string> const& threadWmoList : threadWmoLists)
+        wmoList.insert(threadWmoList.begin(), threadWmoList.end());
+
     if (!wmoList.empty())
     {
         if (FILE* wmoListFile = fopen("wmo_list.txt", "w"))
@@ -1089,7 +1166,7 @@ void ExtractMaps(uint32 build)
         }
     }
 
-    printf("\n");
+    printf("\nConverted %u map files in %u s\n", uint32(queue.ConvertedTiles), GetMSTimeDiffToNow(startTime) / IN_MILLISECONDS);
     delete[] map_ids;
 }
 
@@ -1157,12 +1234,12 @@ void ExtractDBFilesClient(int l)
     printf("Extracted %u files\n\n", count);
 }
 
-bool OpenCascStorage(int locale)
+bool OpenCascStorage(int locale, HANDLE& storage)
 {
     try
     {
         boost::filesystem::path const storage_dir(boost::filesystem::canonical(input_path) / "Data");
-        if (!CascOpenStorage(storage_dir.string().c_str(), WowLocaleToCascLocaleFlags[locale], &CascStorage))
+        if (!CascOpenStorage(storage_dir.string().c_str(), WowLocaleToCascLocaleFlags[locale], &storage))
         {
             printf("error opening casc storage '%s' locale %s: %s\n", storage_dir.string().c_str(), localeNames[locale], HumanReadableCASCError(GetLastError()));
             return false;
@@ -1199,7 +1276,7 @@ int main(int argc, char * arg[])
         if (i == LOCALE_none)
             continue;
 
-        if (!OpenCascStorage(i))
+        if (!OpenCascStorage(i, CascStorage))
             continue;
 
         if ((CONF_extract & EXTRACT_DBC) == 0)
@@ -1243,8 +1320,8 @@ int main(int argc, char * arg[])
 
     if (CONF_extract & EXTRACT_MAP)
     {
-        OpenCascStorage(FirstLocale);
-        ExtractMaps(build);
+        OpenCascStorage(FirstLocale, CascStorage);
+        ExtractMaps(build, FirstLocale);
         CascCloseStorage(CascStorage);
     }
 
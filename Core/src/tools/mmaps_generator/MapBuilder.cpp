@@ -30,6 +30,7 @@
 
 #define MMAP_MAGIC 0x4d4d4150   // 'MMAP'
 #define MMAP_VERSION 7
+#define MMAP_HASH_MAGIC 0x4d4d4853  // 'MMHS'
 
 struct MmapTileHeader
 {
@@ -43,11 +44,52 @@ struct MmapTileHeader
         mmapVersion(MMAP_VERSION), size(0), usesLiquids(true) {}
 };
 
+// stored next to each tile as .mmhash, lets the generator skip tiles whose input did not change
+struct MmapTileInputHash
+{
+    uint32 hashMagic;
+    uint32 written;                                         // an .mmtile was written for this input
+    uint64 hash;
+};
+
+namespace
+{
+    // 64 bit FNV-1a
+    class TileInputHasher
+    {
+        public:
+            TileInputHasher() : _hash(14695981039346656037ULL) { }
+
+            void Add(void const* data, std::size_t size)
+            {
+                uint8 const* bytes = static_cast<uint8 const*>(data);
+                for (std::size_t i = 0; i < size; ++i)
+                    _hash = (_hash ^ bytes[i]) * 1099511628211ULL;
+            }
+
+            template<class T>
+            void Add(T const& value) { Add(&value, sizeof(T)); }
+
+            template<class T>
+            void Add(G3D::Array<T> const& values)
+            {
+                Add(uint32(values.size()));
+                if (values.size())
+                    Add(values.getCArray(), values.size() * sizeof(T));
+            }
+
+            uint64 GetHash() const { return _hash; }
+
+        private:
+            uint64 _hash;
+    };
+}
+
 namespace MMAP
 {
     MapBuilder::MapBuilder(float maxWalkableAngle, bool skipLiquid,
         bool skipContinents, bool skipJunkMaps, bool skipBattlegrounds,
-        bool debugOutput, bool bigBaseUnit, const char* offMeshFilePath) :
+        bool debugOutput, bool bigBaseUnit, const char* offMeshFilePath, bool rebuildAll) :
         m_terrainBuilder     (NULL),
         m_debugOutput        (debugOutput),
         m_offMeshFilePath    (offMeshFilePath),
@@ -56,8 +98,10 @@ namespace MMAP
         m_skipBattlegrounds  (skipBattlegrounds),
         m_maxWalkableAngle   (maxWalkableAngle),
         m_bigBaseUnit        (bigBaseUnit),
+        m_rebuildAll         (rebuildAll),
         m_rcContext          (NULL),
-        _cancelationToken    (false)
+        m_builtTiles         (0),
+        m_unchangedTiles     (0)
     {
         m_terrainBuilder = new TerrainBuilder(skipLiquid);
 
@@ -157,59 +201,136 @@ namespace MMAP
     }
 
     /**************************************************************************/
-
-    void MapBuilder::WorkerThread()
+    std::set<uint32>* MapBuilder::getTilesToBuild(uint32 mapID)
     {
-        while (1)
-        {
-            uint32 mapId = 0;
-
-            _queue.WaitAndPop(mapId);
+        std::set<uint32>* tiles = getTileList(mapID);
 
-            if (_cancelationToken)
-                return;
+        // make sure we process maps which don't have tiles
+        if (!tiles->size())
+        {
+            // convert coord bounds to grid bounds
+            uint32 minX, minY, maxX, maxY;
+            getGridBounds(mapID, minX, minY, maxX, maxY);
 
-            buildMap(mapId);
+            // add all tiles within bounds to tile list.
+            for (uint32 i = minX; i <= maxX; ++i)
+                for (uint32 j = minY; j <= maxY; ++j)
+                    tiles->insert(StaticMapTree::packTileID(i, j));
         }
+
+        return tiles;
     }
 
     void MapBuilder::buildAllMaps(int threads)
     {
-        for (int i = 0; i < threads; ++i)
+        struct MapBuildState
         {
-            _workerThreads.push_back(std::thread(&MapBuilder::WorkerThread, this));
-        }
+            uint32 MapId;
+            dtNavMeshParams NavMeshParams;
+            std::atomic<uint32> RemainingTiles;
+        };
 
         m_tiles.sort([](MapTiles a, MapTiles b)
         {
             return a.m_tiles->size() > b.m_tiles->size();
         });
 
+        // largest maps first, their tiles are spread over all threads instead of keeping one thread busy until the end
+        std::list<MapBuildState> maps;
+        std::vector<std::pair<MapBuildState*, uint32>> tiles;
         for (TileList::iterator it = m_tiles.begin(); it != m_tiles.end(); ++it)
         {
             uint32 mapId = it->m_mapId;
-            if (!shouldSkipMap(mapId))
+            if (shouldSkipMap(mapId))
+                continue;
+
+            std::set<uint32>* mapTiles = getTilesToBuild(mapId);
+            if (mapTiles->empty())
+            {
+                printf("[Map %04u] Complete!\n", mapId);
+                continue;
+            }
+
+            dtNavMesh* navMesh = NULL;
+            buildNavMesh(mapId, navMesh);
+            if (!navMesh)
+            {
+                printf("[Map %04i] Failed creating navmesh!\n", mapId);
+                continue;
+            }
+
+            maps.emplace_back();
+            MapBuildState& map = maps.back();
+            map.MapId = mapId;
+            map.NavMeshParams = *navMesh->getParams();
+            dtFreeNavMesh(navMesh);
+
+            uint32 tileCount = 0;
+            for (std::set<uint32>::iterator tile = mapTiles->begin(); tile != mapTiles->end(); ++tile)
             {
-                if (threads > 0)
-                    _queue.Push(mapId);
-                else
-                    buildMap(mapId);
+                uint32 tileX, tileY;
+                StaticMapTree::unpackTileID(*tile, tileX, tileY);
+                if (shouldSkipTile(mapId, tileX, tileY))
+                    continue;
+
+                tiles.emplace_back(&map, *tile);
+                ++tileCount;
             }
+
+            map.RemainingTiles = tileCount;
+            printf("[Map %04i] We have %u tiles.                          \n", mapId, tileCount);
+            if (!tileCount)
+                printf("[Map %04u] Complete!\n", mapId);
         }
 
-        while (!_queue.Empty())
+        std::atomic<std::size_t> nextTile(0);
+        auto worker = [this, &tiles, &nextTile]()
         {
-            std::this_thread::sleep_for(std::chrono::milliseconds(1000));
-        }
+            // tiles of a map are next to each other in the list, keep the navmesh until the map changes
+            MapBuildState* navMeshMap = NULL;
+            dtNavMesh* navMesh = NULL;
+            for (std::size_t i = nextTile++; i < tiles.size(); i = nextTile++)
+            {
+                MapBuildState* map = tiles[i].first;
+                if (map != navMeshMap)
+                {
+                    dtFreeNavMesh(navMesh);
+                    navMesh = dtAllocNavMesh();
+                    if (!navMesh->init(&map->NavMeshParams))
+                    {
+                        printf("[Map %04u] Failed creating navmesh!                \n", map->MapId);
+                        dtFreeNavMesh(navMesh);
+                        navMesh = NULL;
+                    }
+
+                    navMeshMap = map;
+                }
 
-        _cancelationToken = true;
+                if (navMesh)
+                {
+                    uint32 tileX, tileY;
+                    StaticMapTree::unpackTileID(tiles[i].second, tileX, tileY);
+                    buildTile(map->MapId, tileX, tileY, navMesh);
+                }
 
-        _queue.Cancel();
+                if (--map->RemainingTiles == 0)
+                    printf("[Map %04u] Complete!\n", map->MapId);
+            }
 
-        for (auto& thread : _workerThreads)
-        {
+            dtFreeNavMesh(navMesh);
+        };
+
+        std::vector<std::thread> workerThreads;
+        for (int i = 0; i < threads; ++i)
+            workerThreads.push_back(std::thread(worker));
+
+        if (threads <= 0)
+            worker();
+
+        for (std::thread& thread : workerThreads)
             thread.join();
-        }
+
+        printf("Built %u tiles, %u tiles were unchanged.\n", uint32(m_builtTiles), uint32(m_unchangedTiles));
     }
 
     /**************************************************************************/
@@ -362,20 +483,7 @@ namespace MMAP
         //printf("[Thread %u] Building map %03u:\n", uint32(ACE_Thread::self()), mapID);
 #endif
 
-        std::set<uint32>* tiles = getTileList(mapID);
-
-        // make sure we process maps which don't have tiles
-        if (!tiles->size())
-        {
-            // convert coord bounds to grid bounds
-            uint32 minX, minY, maxX, maxY;
-            getGridBounds(mapID, minX, minY, maxX, maxY);
-
-            // add all tiles within bounds to tile list.
-            for (uint32 i = minX; i <= maxX; ++i)
-                for (uint32 j = minY; j <= maxY; ++j)
-                    tiles->insert(StaticMapTree::packTileID(i, j));
-        }
+        std::set<uint32>* tiles = getTilesToBuild(mapID);
 
         if (!tiles->empty())
         {
@@ -444,8 +552,98 @@ namespace MMAP
 
         m_terrainBuilder->loadOffMeshConnections(mapID, tileX, tileY, meshData, m_offMeshFilePath);
 
+        // debug output is only written while building, always build when it is requested
+        uint64 inputHash = getTileInputHash(meshData, bmin, bmax, navMesh);
+        if (!m_rebuildAll && !m_debugOutput && isTileUpToDate(mapID, tileX, tileY, inputHash))
+        {
+            printf("[Map %04i] Tile [%02u,%02u] is unchanged\n", mapID, tileX, tileY);
+            ++m_unchangedTiles;
+            return;
+        }
+
         // build navmesh tile
-        buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh);
+        TileBuildResult result = buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh);
+        if (result != TILE_BUILD_FAILED)
+            saveTileInputHash(mapID, tileX, tileY, inputHash, result == TILE_BUILD_WRITTEN);
+
+        ++m_builtTiles;
+    }
+
+    /**************************************************************************/
+    uint64 MapBuilder::getTileInputHash(MeshData const& meshData, float const* bmin, float const* bmax, dtNavMesh const* navMesh)
+    {
+        TileInputHasher hasher;
+        hasher.Add(uint32(MMAP_VERSION));
+        hasher.Add(uint32(DT_NAVMESH_VERSION));
+        hasher.Add(m_maxWalkableAngle);
+        hasher.Add(m_bigBaseUnit);
+        hasher.Add(m_terrainBuilder->usesLiquids());
+
+        // the tile position inside the navmesh is stored in the tile data
+        dtNavMeshParams const* params = navMesh->getParams();
+        hasher.Add(params->orig, sizeof(params->orig));
+        hasher.Add(params->tileWidth);
+        hasher.Add(params->tileHeight);
+        hasher.Add(bmin, sizeof(float) * 3);
+        hasher.Add(bmax, sizeof(float) * 3);
+
+        hasher.Add(meshData.solidVerts);
+        hasher.Add(meshData.solidTris);
+        hasher.Add(meshData.liquidVerts);
+        hasher.Add(meshData.liquidTris);
+        hasher.Add(meshData.liquidType);
+        hasher.Add(meshData.offMeshConnections);
+        hasher.Add(meshData.offMeshConnectionRads);
+        hasher.Add(meshData.offMeshConnectionDirs);
+        hasher.Add(meshData.offMeshConnectionsAreas);
+        hasher.Add(meshData.offMeshConnectionsFlags);
+        return hasher.GetHash();
+    }
+
+    /**************************************************************************/
+    bool MapBuilder::isTileUpToDate(uint32 mapID, uint32 tileX, uint32 tileY, uint64 inputHash)
+    {
+        char fileName[255];
+        sprintf(fileName, "mmaps/%04u%02i%02i.mmhash", mapID, tileY, tileX);
+        FILE* file = fopen(fileName, "rb");
+        if (!file)
+            return false;
+
+        MmapTileInputHash saved;
+        bool read = fread(&saved, sizeof(MmapTileInputHash), 1, file) == 1;
+        fclose(file);
+
+        if (!read || saved.hashMagic != MMAP_HASH_MAGIC || saved.hash != inputHash)
+            return false;
+
+        if (!saved.written)
+            return true;
+
+        // the tile itself might have been deleted since
+        sprintf(fileName, "mmaps/%04u%02i%02i.mmtile", mapID, tileY, tileX);
+        file = fopen(fileName, "rb");
+        if (!file)
+            return false;
+
+        fclose(file);
+        return true;
+    }
+
+    /**************************************************************************/
+    void MapBuilder::saveTileInputHash(uint32 mapID, uint32 tileX, uint32 tileY, uint64 inputHash, bool written)
+    {
+        char fileName[255];
+        sprintf(fileName, "mmaps/%04u%02i%02i.mmhash", mapID, tileY, tileX);
+        FILE* file = fopen(fileName, "wb");
+        if (!file)
+            return;
+
+        MmapTileInputHash saved;
+        saved.hashMagic = MMAP_HASH_MAGIC;
+        saved.written = written ? 1 : 0;
+        saved.hash = inputHash;
+        fwrite(&saved, sizeof(MmapTileInputHash), 1, file);
+        fclose(file);
     }
 
     /**************************************************************************/
@@ -524,7 +722,7 @@ namespace MMAP
     }
 
     /**************************************************************************/
-    void MapBuilder::buildMoveMapTile(uint32 mapID, uint32 tileX, uint32 tileY,
+    TileBuildResult MapBuilder::buildMoveMapTile(uint32 mapID, uint32 tileX, uint32 tileY,
         MeshData &meshData, float bmin[3], float bmax[3],
         dtNavMesh* navMesh)
     {
@@ -700,7 +898,7 @@ namespace MMAP
             delete[] pmmerge;
             delete[] dmmerge;
             delete[] tiles;
-            return;
+            return TILE_BUILD_FAILED;
         }
         rcMergePolyMeshes(m_rcContext, pmmerge, nmerge, *iv.polyMesh);
 
@@ -711,7 +909,7 @@ namespace MMAP
             delete[] pmmerge;
             delete[] dmmerge;
             delete[] tiles;
-            return;
+            return TILE_BUILD_FAILED;
         }
         rcMergePolyMeshDetails(m_rcContext, dmmerge, nmerge, *iv.polyMeshDetail);
 
@@ -764,6 +962,7 @@ namespace MMAP
         // will hold final navmesh
         unsigned char* navData = NULL;
         int navDataSize = 0;
+        TileBuildResult result = TILE_BUILD_FAILED;
 
         do
         {
@@ -786,6 +985,7 @@ namespace MMAP
 
                 // message is an annoyance
                 //printf("%sNo vertices to build tile!              \n", tileString.c_str());
+                result = TILE_BUILD_EMPTY;
                 break;
             }
             if (!params.polyCount || !params.polys ||
@@ -795,6 +995,7 @@ namespace MMAP
                 // keep in mind that we do output those into debug info
                 // drop tiles with only exact count - some tiles may have geometry while having less tiles
                 printf("%s No polygons to build on tile!              \n", tileString.c_str());
+                result = TILE_BUILD_EMPTY;
                 break;
             }
             if (!params.detailMeshes || !params.detailVerts || !params.detailTris)
@@ -848,6 +1049,7 @@ namespace MMAP
 
             // now that tile is written to disk, we can unload it
             navMesh->removeTile(tileRef, NULL, NULL);
+            result = TILE_BUILD_WRITTEN;
         }
         while (0);
 
@@ -864,6 +1066,8 @@ namespace MMAP
             iv.generateObjFile(mapID, tileX, tileY, meshData);
             iv.writeIV(mapID, tileX, tileY);
         }
+
+        return result;
     }
 
     /**************************************************************************/
@@ -31,7 +31,6 @@
 
 #include "Recast.h"
 #include "DetourNavMesh.h"
-#include "ProducerConsumerQueue.h"
 
 using namespace VMAP;
 
@@ -55,6 +54,13 @@ namespace MMAP
 
     typedef std::list<MapTiles> TileList;
 
+    enum TileBuildResult
+    {
+        TILE_BUILD_FAILED,
+        TILE_BUILD_EMPTY,                                   // nothing to walk on, no file written
+        TILE_BUILD_WRITTEN
+    };
+
     struct Tile
     {
         Tile() : chf(NULL), solid(NULL), cset(NULL), pmesh(NULL), dmesh(NULL) {}
@@ -83,7 +89,8 @@ namespace MMAP
                 bool skipBattlegrounds   = false,
                 bool debugOutput         = false,
                 bool bigBaseUnit         = false,
-                const char* offMeshFilePath = NULL);
+                const char* offMeshFilePath = NULL,
+                bool rebuildAll          = false);
 
             ~MapBuilder();
 
@@ -95,21 +102,28 @@ namespace MMAP
             void buildSingleTile(uint32 mapID, uint32 tileX, uint32 tileY);
 
             // builds list of maps, then builds all of mmap tiles (based on the skip settings)
+            // tiles of all maps are handed out to the threads one by one
             void buildAllMaps(int threads);
 
-            void WorkerThread();
-
         private:
             // detect maps and tiles
             void discoverTiles();
             std::set<uint32>* getTileList(uint32 mapID);
+            // tile list of the map, filled from the model bounds for maps without tiles
+            std::set<uint32>* getTilesToBuild(uint32 mapID);
 
             void buildNavMesh(uint32 mapID, dtNavMesh* &navMesh);
 
             void buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh);
 
+            // hash of everything the tile is built from: geometry, offmesh connections and settings
+            uint64 getTileInputHash(MeshData const& meshData, float const* bmin, float const* bmax, dtNavMesh const* navMesh);
+            // true if the tile was built from the same input before and its output is still there
+            bool isTileUpToDate(uint32 mapID, uint32 tileX, uint32 tileY, uint64 inputHash);
+            void saveTileInputHash(uint32 mapID, uint32 tileX, uint32 tileY, uint64 inputHash, bool written);
+
             // move map building
-            void buildMoveMapTile(uint32 mapID,
+            TileBuildResult buildMoveMapTile(uint32 mapID,
                 uint32 tileX,
                 uint32 tileY,
                 MeshData &meshData,
@@ -139,12 +153,13 @@ namespace MMAP
             float m_maxWalkableAngle;
             bool m_bigBaseUnit;
 
+            bool m_rebuildAll;
+
             // build performance - not really used for now
             rcContext* m_rcContext;
 
-            std::vector<std::thread> _workerThreads;
-            ProducerConsumerQueue<uint32> _queue;
-            std::atomic<bool> _cancelationToken;
+            std::atomic<uint32> m_builtTiles;
+            std::atomic<uint32> m_unchangedTiles;
     };
 }
 
@@ -73,7 +73,8 @@ bool handleArgs(int argc, char** argv,
                bool &bigBaseUnit,
                char* &offMeshInputPath,
                char* &file,
-               int& threads)
+               int& threads,
+               bool &rebuildAll)
 {
     char* param = NULL;
     for (int i = 1; i < argc; ++i)
@@ -196,6 +197,10 @@ bool handleArgs(int argc, char** argv,
         {
             silent = true;
         }
+        else if (strcmp(argv[i], "--rebuild") == 0)
+        {
+            rebuildAll = true;
+        }
         else if (strcmp(argv[i], "--bigBaseUnit") == 0)
         {
             param = argv[++i];
@@ -251,14 +256,15 @@ int main(int argc, char** argv)
          skipBattlegrounds = false,
          debugOutput = false,
          silent = false,
-         bigBaseUnit = false;
+         bigBaseUnit = false,
+         rebuildAll = false;
     char* offMeshInputPath = NULL;
     char* file = NULL;
 
     bool validParam = handleArgs(argc, argv, mapnum,
                                  tileX, tileY, maxAngle,
                                  skipLiquid, skipContinents, skipJunkMaps, skipBattlegrounds,
-                                 debugOutput, silent, bigBaseUnit, offMeshInputPath, file, threads);
+                                 debugOutput, silent, bigBaseUnit, offMeshInputPath, file, threads, rebuildAll);
 
     if (!validParam)
         return silent ? -1 : finish("You have specified invalid parameters", -1);
@@ -279,7 +285,7 @@ int main(int argc, char** argv)
         return silent ? -3 : finish("Press ENTER to close...", -3);
 
     MapBuilder builder(maxAngle, skipLiquid, skipContinents, skipJunkMaps,
-                       skipBattlegrounds, debugOutput, bigBaseUnit, offMeshInputPath);
+                       skipBattlegrounds, debugOutput, bigBaseUnit, offMeshInputPath, rebuildAll);
 
     uint32 start = getMSTime();
     if (file)
@@ -16,25 +16,28 @@
  * with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <cstdlib>
 #include <string>
 #include <iostream>
+#include <thread>
 
 #include "TileAssembler.h"
 
 int main(int argc, char* argv[])
 {
-    if (argc != 3)
+    if (argc != 3 && argc != 4)
     {
-        std::cout << "usage: " << argv[0] << " <raw data dir> <vmap dest dir>" << std::endl;
+        std::cout << "usage: " << argv[0] << " <raw data dir> <vmap dest dir> [threads]" << std::endl;
         return 1;
     }
 
     std::string src = argv[1];
     std::string dest = argv[2];
+    unsigned int threads = argc == 4 ? atoi(argv[3]) : std::thread::hardware_concurrency();
 
     std::cout << "using " << src << " as source directory and writing output to " << dest << std::endl;
 
-    VMAP::TileAssembler* ta = new VMAP::TileAssembler(src, dest);
+    VMAP::TileAssembler* ta = new VMAP::TileAssembler(src, dest, threads);
 
     if (!ta->convertWorld2())
     {
@@ -52,7 +52,7 @@ bool ExtractSingleModel(std::string& fname)
     return mdl.ConvertToVMAPModel(output.c_str());
 }
 
-extern HANDLE CascStorage;
+extern thread_local HANDLE CascStorage;
 
 void ExtractGameobjectModels()
 {
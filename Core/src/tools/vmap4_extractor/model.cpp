@@ -24,7 +24,7 @@
 #include <algorithm>
 #include <cstdio>
 
-extern HANDLE CascStorage;
+extern thread_local HANDLE CascStorage;
 
 Model::Model(std::string &filename) : filename(filename), vertices(0), indices(0)
 {
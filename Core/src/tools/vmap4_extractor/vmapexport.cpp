@@ -17,10 +17,13 @@
  */
 
 #define _CRT_SECURE_NO_DEPRECATE
+#include <atomic>
 #include <cstdio>
 #include <iostream>
 #include <vector>
 #include <list>
+#include <set>
+#include <thread>
 #include <errno.h>
 
 #ifdef WIN32
@@ -49,6 +52,7 @@
 #include "mpqfile.h"
 
 #include "vmapexport.h"
+#include "Timer.h"
 
 #include <boost/filesystem/path.hpp>
 #include <boost/filesystem/operations.hpp>
@@ -60,7 +64,7 @@
 
 //-----------------------------------------------------------------------------
 
-HANDLE CascStorage = NULL;
+thread_local HANDLE CascStorage = NULL;                     // WMO extraction threads open their own storage
 
 typedef struct
 {
@@ -74,6 +78,7 @@ uint32 map_count;
 char output_path[128] = ".";
 char input_path[1024] = ".";
 bool preciseVectorData = false;
+uint32 threadCount = std::max(std::thread::hardware_concurrency(), 1u);
 
 // Constants
 
@@ -247,9 +252,9 @@ void ReadLiquidTypeTableDBC()
     printf("Done! (%u LiqTypes loaded)\n", (unsigned int)LiqType_count);
 }
 
-bool ExtractWmo()
+bool ExtractWmo(int locale)
 {
-    bool success = true;
+    std::atomic<bool> success(true);
 
     std::ifstream wmoList("wmo_list.txt");
     if (!wmoList)
@@ -269,8 +274,43 @@ bool ExtractWmo()
         wmos.insert(std::move(str));
     }
 
-    for (std::string str : wmos)
-        success &= ExtractSingleWmo(str);
+    // files with the same name in different directories are written to the same output file,
+    // only the first one is extracted like when extracting them one by one
+    std::vector<std::string> wmoFiles;
+    std::set<std::string> localFiles;
+    for (std::string const& wmo : wmos)
+    {
+        std::string localFile = std::string(szWorkDirWmo) + "/" + GetPlainName(wmo.c_str());
+        FixNameCase(&localFile[0], localFile.length());
+        if (localFiles.insert(std::move(localFile)).second)
+            wmoFiles.push_back(wmo);
+    }
+
+    std::atomic<std::size_t> nextWmo(0);
+    auto extract = [&wmoFiles, &nextWmo, &success]()
+    {
+        for (std::size_t i = nextWmo++; i < wmoFiles.size(); i = nextWmo++)
+            if (!ExtractSingleWmo(wmoFiles[i]))
+                success = false;
+    };
+
+    std::vector<std::thread> threads;
+    for (uint32 i = 1; i < std::min<std::size_t>(threadCount, wmoFiles.size()); ++i)
+    {
+        threads.push_back(std::thread([&extract, locale]()
+        {
+            if (!OpenCascStorage(locale))
+                return;
+
+            extract();
+            CascCloseStorage(CascStorage);
+        }));
+    }
+
+    extract();
+
+    for (std::thread& thread : threads)
+        thread.join();
 
     if (success)
         printf("\nExtract wmo complete (No (fatal) errors)\n");
@@ -426,6 +466,13 @@ bool processArgv(int argc, char ** argv, const char *versionString)
         {
             preciseVectorData = true;
         }
+        else if(strcmp("-t",argv[i]) == 0)
+        {
+            if((i+1)<argc && atoi(argv[i + 1]) > 0)
+                threadCount = atoi(argv[++i]);
+            else
+                result = false;
+        }
         else
         {
             result = false;
@@ -436,10 +483,11 @@ bool processArgv(int argc, char ** argv, const char *versionString)
     if (!result)
     {
         printf("Extract %s.\n",versionString);
-        printf("%s [-?][-s][-l][-d <path>]\n", argv[0]);
+        printf("%s [-?][-s][-l][-d <path>][-t <threads>]\n", argv[0]);
         printf("   -s : (default) small size (data size optimization), ~500MB less vmap data.\n");
         printf("   -l : large size, ~500MB more vmap data. (might contain more details)\n");
         printf("   -d <path>: Path to the vector data source folder.\n");
+        printf("   -t <threads>: Number of threads extracting WMO files, defaults to the number of cores.\n");
         printf("   -? : This message.\n");
     }
 
@@ -523,14 +571,20 @@ int main(int argc, char ** argv)
         return 1;
     }
 
+    uint32 stageStart = getMSTime();
+
     // Extract models, listed in GameObjectDisplayInfo.dbc
     ExtractGameobjectModels();
+    uint32 gameobjectModelsTime = GetMSTimeDiffToNow(stageStart);
 
     ReadLiquidTypeTableDBC();
 
     // extract data
+    stageStart = getMSTime();
     if (success)
-        success = ExtractWmo();
+        success = ExtractWmo(FirstLocale);
+    uint32 wmoTime = GetMSTimeDiffToNow(stageStart);
+    uint32 mapTime = 0;
 
     //xxxxxxxxxxxxxxxxxxxxxxxxxxxxxx
     //map.dbc
@@ -566,10 +620,15 @@ int main(int argc, char ** argv)
         }
 
         delete dbc;
+        stageStart = getMSTime();
         ParsMapFiles();
+        mapTime = GetMSTimeDiffToNow(stageStart);
         delete [] map_ids;
     }
 
+    printf("\nGameobject models: %u s, WMO files: %u s (%u threads), maps: %u s\n", gameobjectModelsTime / IN_MILLISECONDS,
+        wmoTime / IN_MILLISECONDS, threadCount, mapTime / IN_MILLISECONDS);
+
     CascCloseStorage(CascStorage);
 
     printf("\n");
@@ -39,7 +39,7 @@ WMORoot::WMORoot(std::string &filename)
     memset(bbcorn2, 0, sizeof(bbcorn2));
 }
 
-extern HANDLE CascStorage;
+extern thread_local HANDLE CascStorage;
 
 bool WMORoot::open()
 {